@@ -69,11 +69,15 @@ class Cache {
       flatbuffers::FlatBufferBuilder& builder, std::string_view schemaVersion,
       const std::filesystem::path& origFileName);
 
-  std::pair<flatbuffers::Offset<VectorOffsetError>,
-            flatbuffers::Offset<VectorOffsetString>>
-  cacheErrors(flatbuffers::FlatBufferBuilder& builder,
-              SymbolTable& canonicalSymbols, ErrorContainer* errorContainer,
-              SymbolTable* symbols, SymbolId subjectId);
+  // Registers the symbols of the cached errors in canonicalSymbols
+  flatbuffers::Offset<VectorOffsetError> cacheErrors(
+      flatbuffers::FlatBufferBuilder& builder, SymbolTable& canonicalSymbols,
+      ErrorContainer* errorContainer, SymbolTable* symbols, SymbolId subjectId);
+
+  // To be created once all the symbols of the cache are registered
+  flatbuffers::Offset<VectorOffsetString> cacheSymbols(
+      flatbuffers::FlatBufferBuilder& builder,
+      const SymbolTable& canonicalSymbols);
 
   void restoreErrors(const VectorOffsetError* errorsBuf,
                      const VectorOffsetString* symbolBuf,
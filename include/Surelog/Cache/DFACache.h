@@ -0,0 +1,62 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_DFACACHE_H
+#define SURELOG_DFACACHE_H
+#pragma once
+
+#include <Surelog/Cache/Cache.h>
+
+#include <cstdint>
+#include <filesystem>
+
+namespace antlr4 {
+class Parser;
+}
+
+namespace SURELOG {
+
+// Snapshot of the prediction DFA of a generated ANTLR parser. The DFA is
+// built lazily during parsing and is shared (static) by all the instances of
+// a parser class; restoring a snapshot taken after a training run saves the
+// adaptive prediction cost of every decision already seen.
+//
+// The snapshot is only restored if it was taken with the same grammar: the
+// serialized ATN of the parser must match. Decisions that already have DFA
+// states are left untouched.
+class DFACache : Cache {
+ public:
+  DFACache(antlr4::Parser* parser, const std::filesystem::path& cacheDir);
+
+  bool restore();
+  bool save();
+
+  // Number of DFA states restored
+  uint64_t getNbRestoredStates() const { return m_nbRestoredStates; }
+
+ private:
+  DFACache(const DFACache& orig) = delete;
+
+  bool restore_(const uint8_t* buffer);
+
+  antlr4::Parser* const m_parser;
+  const std::filesystem::path m_cacheFileName;
+  uint64_t m_nbRestoredStates = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_DFACACHE_H */
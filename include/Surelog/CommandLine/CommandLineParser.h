@@ -144,6 +144,9 @@ class CommandLineParser final {
   void setParse(bool val) { m_parse = val; }
   void setParseOnly(bool val) { m_parseOnly = val; }
   void setLowMem(bool val) { m_lowMem = val; }
+  void setStreamParse(bool val) { m_streamParse = val; }
+  void setFastLexer(bool val) { m_fastLexer = val; }
+  void setProfile(bool val) { m_profile = val; }
   void setCompile(bool val) { m_compile = val; }
   void setElaborate(bool val) { m_elaborate = val; }
   void setElabUhdm(bool val) {
@@ -182,9 +185,16 @@ class CommandLineParser final {
   unsigned int getNbLinesForFileSpliting() const {
     return m_nbLinesForFileSplitting;
   }
+  void setNbLinesForFileSpliting(unsigned int nbLines) {
+    m_nbLinesForFileSplitting = nbLines;
+  }
   bool useTbb() const { return m_useTbb; }
   std::string getTimeScale() const { return m_timescale; }
   bool createCache() const { return m_createCache; }
+  bool dfaCache() const { return m_dfaCache; }
+  bool createDfaCache() const { return m_createDfaCache; }
+  bool fastLexer() const { return m_fastLexer; }
+  bool streamParse() const { return m_streamParse; }
   std::string currentDateTime();
   bool parseBuiltIn();
   std::filesystem::path getBuiltInPath() const { return m_builtinPath; }
@@ -278,6 +288,10 @@ class CommandLineParser final {
   SymbolId m_pythonListenerFileId;
   bool m_debugIncludeFileInfo;
   bool m_createCache;
+  bool m_dfaCache;
+  bool m_createDfaCache;
+  bool m_fastLexer;
+  bool m_streamParse;
   bool m_profile;
   bool m_parseBuiltIn;
   bool m_ppOutputFileLocation;
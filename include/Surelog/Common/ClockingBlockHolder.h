@@ -28,7 +28,8 @@
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/Design/ClockingBlock.h>
 
-#include <map>
+#include <utility>
+#include <vector>
 
 namespace SURELOG {
 
@@ -36,7 +37,9 @@ class ClockingBlock;
 
 class ClockingBlockHolder {
  public:
-  typedef std::multimap<SymbolId, ClockingBlock> ClockingBlockMap;
+  // In declaration order: SymbolIds are assigned in thread scheduling
+  // order, the UHDM model is written in the order of this container
+  typedef std::vector<std::pair<SymbolId, ClockingBlock>> ClockingBlockMap;
 
   virtual ~ClockingBlockHolder() {}  // virtual as used as interface
 
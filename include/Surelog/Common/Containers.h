@@ -13,7 +13,6 @@ class ClassDefinition;
 class ModuleDefinition;
 class Package;
 class Program;
-class MacroInfo;
 
 typedef std::map<std::string, ModuleDefinition*> ModuleNameModuleDefinitionMap;
 typedef std::multimap<std::string, Package*>
@@ -25,9 +24,6 @@ typedef std::multimap<std::string, ClassDefinition*>
     ClassNameClassDefinitionMultiMap;
 typedef std::map<std::string, ClassDefinition*> ClassNameClassDefinitionMap;
 
-typedef std::map<std::string, MacroInfo*> MacroStorage;
-typedef std::map<std::string, MacroInfo*> MacroStorageRef;
-
 }  // namespace SURELOG
 
 #endif  // SURELOG_CONTAINERS_H
@@ -29,6 +29,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace SURELOG {
 
@@ -50,10 +51,15 @@ class DefParam final {
   Value* getValue() const { return m_value; }
   void setValue(Value* value) { m_value = value; }
 
-  void setChild(std::string name, DefParam* child) {
+  void setChild(std::string name, SymbolId id, DefParam* child) {
     m_children.insert(std::make_pair(name, child));
+    m_childIds.insert(std::make_pair(id, child));
   }
   std::map<std::string, DefParam*>& getChildren() { return m_children; }
+  DefParam* getChild(SymbolId id) const {
+    auto itr = m_childIds.find(id);
+    return (itr == m_childIds.end()) ? nullptr : itr->second;
+  }
   bool isUsed() const { return m_used; }
   void setUsed() { m_used = true; }
   void setLocation(const FileContent* fC, NodeId nodeId) {
@@ -68,6 +74,8 @@ class DefParam final {
  private:
   const std::string m_name;
   std::map<std::string, DefParam*> m_children;
+  // Same children, keyed by the interned name
+  std::unordered_map<SymbolId, DefParam*> m_childIds;
   Value* m_value;
   bool m_used;
   DefParam* m_parent;
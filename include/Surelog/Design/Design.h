@@ -30,6 +30,8 @@
 
 #include <map>
 #include <mutex>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace SURELOG {
@@ -135,6 +137,10 @@ class Design final {
 
   DefParam* getDefParam(const std::string& name) const;
 
+  // Defparam targeting the parameter "name" of the instance, found by
+  // walking the interned instance names, without building the path
+  DefParam* getDefParam(ModuleInstance* instance, std::string_view name) const;
+
   Value* getDefParamValue(const std::string& name);
 
   std::map<std::string, DefParam*>& getDefParams() { return m_defParams; }
@@ -179,9 +185,7 @@ class Design final {
     m_moduleDefinitions.insert(std::make_pair(moduleName, def));
   }
 
-  void addTopLevelModuleInstance(ModuleInstance* instance) {
-    m_topLevelModuleInstances.push_back(instance);
-  }
+  void addTopLevelModuleInstance(ModuleInstance* instance);
 
   void addDefParam(const std::string& name, const FileContent* fC,
                    NodeId nodeId, Value* value);
@@ -202,11 +206,13 @@ class Design final {
 
  private:
   ModuleInstance* findInstance_(const std::vector<std::string>& path,
+                                unsigned int index,
                                 ModuleInstance* scope) const;
   void addDefParam_(std::vector<std::string>& path, const FileContent* fC,
                     NodeId nodeId, Value* value, DefParam* parent);
   DefParam* getDefParam_(std::vector<std::string>& path,
                          DefParam* parent) const;
+  DefParam* getDefParamScope_(ModuleInstance* instance) const;
 
   ErrorContainer* m_errors;
 
@@ -222,8 +228,15 @@ class Design final {
 
   std::vector<ModuleInstance*> m_topLevelModuleInstances;
 
+  // Top level instances by instance name, in order
+  std::unordered_map<std::string, std::vector<ModuleInstance*>>
+      m_topLevelModuleInstancesByName;
+
   std::map<std::string, DefParam*> m_defParams;
 
+  // Top of the defparam trie, keyed by the interned names
+  std::unordered_map<SymbolId, DefParam*> m_defParamIds;
+
   PackageNamePackageDefinitionMultiMap m_packageDefinitions;
 
   PackageDefinitionVec m_orderedPackageDefinitions;
@@ -45,7 +45,8 @@ class DesignElement final {
     Function,  // Function is not a Design Element per Standard, but in a
                // package it is a element worth tracking
     Task,
-    SLline  // Used to split files with correct file info
+    Typedef,  // Only used to split files (package typedefs)
+    SLline    // Used to split files with correct file info
   };
 
   DesignElement(SymbolId name, SymbolId fileId, ElemType type,
@@ -66,8 +67,6 @@ class DesignElement final {
   TimeInfo m_timeInfo;
   NodeId m_node;
   VObjectType m_defaultNetType = slNetType_Wire;
-  void* m_context;  // Not persisted field, only used to build the DesignElement
-                    // -> VNode relation
 };
 
 }  // namespace SURELOG
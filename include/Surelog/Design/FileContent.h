@@ -28,7 +28,11 @@
 #include <Surelog/Common/Containers.h>
 #include <Surelog/Design/DesignComponent.h>
 #include <Surelog/Design/VObject.h>
+#include <Surelog/Design/VObjectTypeIndex.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -57,7 +61,7 @@ class FileContent : public DesignComponent {
         m_parentFile(parent) {}
 
   void setLibrary(Library* lib) { m_library = lib; }
-  ~FileContent() override = default;
+  ~FileContent() override;
 
   typedef std::unordered_map<std::string, NodeId> NameIdMap;
 
@@ -144,6 +148,7 @@ class FileContent : public DesignComponent {
   NodeId Parent(NodeId index) const;
 
   VObjectType Type(NodeId index) const;
+  void SetType(NodeId index, VObjectType type);
 
   unsigned int Line(NodeId index) const;
 
@@ -229,6 +234,14 @@ class FileContent : public DesignComponent {
   SymbolTable* m_symbolTable;  // TODO: should be set in constructor *const
   FileContent* m_parentFile;   // for file chunks
   bool m_isLibraryCellFile = false;
+
+ private:
+  // Built on the first sl_collect query, see VObjectTypeIndex
+  const VObjectTypeIndex* typeIndex_() const;
+
+  mutable std::mutex m_typeIndexMutex;
+  mutable std::unique_ptr<VObjectTypeIndex> m_typeIndexStorage;
+  mutable std::atomic<const VObjectTypeIndex*> m_typeIndex{nullptr};
 };
 
 };  // namespace SURELOG
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <string_view>
+#include <unordered_map>
 
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/Design/ValuedComponentI.h>
@@ -76,6 +77,7 @@ class ModuleInstance : public ValuedComponentI {
   VObjectType getType() const;
   VObjectType getModuleType();
   SymbolId getFullPathId(SymbolTable* symbols);
+  // Cached, the instance name is interned once per symbol table
   SymbolId getInstanceId(SymbolTable* symbols);
   SymbolId getModuleNameId(SymbolTable* symbols);
   std::string getInstanceName();
@@ -106,15 +108,25 @@ class ModuleInstance : public ValuedComponentI {
   std::string decompile(char* valueName) final;
 
   ModuleInstance* getChildByName(const std::string& name);
+  // The children with this instance name, in order, nullptr if none
+  const std::vector<ModuleInstance*>* getChildrenByName(
+      const std::string& name);
 
  private:
   DesignComponent* m_definition;
   std::vector<ModuleInstance*> m_allSubInstances;
+  // Index of the children by instance name, built on lookup. The first
+  // m_nbIndexedChildren sub-instances are in it.
+  std::unordered_map<std::string, std::vector<ModuleInstance*>>
+      m_childrenByName;
+  size_t m_nbIndexedChildren = 0;
   const FileContent* m_fileContent;
   NodeId m_nodeId;
   ModuleInstance* m_parent;
   std::string m_instName;  // Can carry the moduleName@instanceName if the
                            // module is undefined
+  SymbolId m_instanceId = 0;
+  const SymbolTable* m_instanceIdSymbols = nullptr;
   std::vector<Parameter*> m_typeParams;
   Netlist* m_netlist;
   ModuleInstance* m_boundInstance = nullptr;
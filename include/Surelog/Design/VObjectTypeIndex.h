@@ -0,0 +1,77 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_VOBJECTTYPEINDEX_H
+#define SURELOG_VOBJECTTYPEINDEX_H
+#pragma once
+
+#include <Surelog/Common/SymbolId.h>
+#include <Surelog/SourceCompile/VObjectTypes.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace SURELOG {
+
+class VObject;
+
+// Pre-order numbering of a FileContent tree (following the child/sibling
+// links from node 0) with the rank past the end of every subtree, and the
+// sorted ranks of the nodes of each VObjectType. The nodes of a type under
+// a parent are then a binary searched range of that type's ranks, and the
+// subtrees under stop points are excluded intervals.
+class VObjectTypeIndex final {
+ public:
+  explicit VObjectTypeIndex(const std::vector<VObject>& objects);
+  VObjectTypeIndex(const VObjectTypeIndex&) = delete;
+  VObjectTypeIndex& operator=(const VObjectTypeIndex&) = delete;
+
+  // Number of objects in the storage when the index was built
+  size_t nodeCount() const { return m_ranks.size(); }
+
+  // False for the nodes not reachable from node 0
+  bool contains(NodeId node) const {
+    return (node < m_ranks.size()) && (m_ranks[node] != kNotRanked);
+  }
+
+  // Nodes of one of the types in the subtree of parent (parent itself only
+  // if includeParent), in pre-order. The descendants of nodes of a
+  // stopPoints type are skipped. Only the first match if first.
+  std::vector<NodeId> collect(NodeId parent, bool includeParent,
+                              const std::vector<VObjectType>& types,
+                              const std::vector<VObjectType>& stopPoints,
+                              bool first) const;
+
+  // Keeps the index in sync when the type of a node changes
+  void retype(NodeId node, unsigned short from, unsigned short to);
+
+ private:
+  static constexpr unsigned int kNotRanked = ~0U;
+
+  // Ranks of the nodes of the given types within [begin, end), sorted
+  void ranksInRange_(const std::vector<VObjectType>& types, unsigned int begin,
+                     unsigned int end, bool first,
+                     std::vector<unsigned int>& ranks) const;
+
+  std::vector<unsigned int> m_ranks;       // NodeId -> pre-order rank
+  std::vector<unsigned int> m_subtreeEnd;  // NodeId -> rank past its subtree
+  std::vector<NodeId> m_nodes;             // Rank -> NodeId
+  std::vector<std::vector<unsigned int>> m_typeRanks;  // Type -> ranks
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_VOBJECTTYPEINDEX_H */
@@ -68,7 +68,6 @@ class CompileDesign {
   bool elaboration_();
 
   Compiler* const m_compiler;
-  std::vector<SymbolTable*> m_symbolTables;
   std::vector<ErrorContainer*> m_errorContainers;
 
   std::mutex m_serializerMutex;
@@ -0,0 +1,89 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_ASYNCLOGLISTENER_H
+#define SURELOG_ASYNCLOGLISTENER_H
+#pragma once
+
+#include <Surelog/ErrorReporting/LogListener.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace SURELOG {
+
+// A log listener that writes to the log file from a background thread.
+// Once initialized, log() only copies the message into a bounded ring
+// shared by all the reporting threads; the writer thread appends the
+// pending messages to the file in batches, one write per batch, keeping
+// the file open. When the ring is full, log() waits for the writer
+// (back-pressure): messages are never dropped. flush() returns once every
+// message logged before the call is on disk, the destructor drains the
+// ring. Before initialize(), messages are queued as in LogListener.
+class AsyncLogListener : public LogListener {
+ public:
+  static constexpr unsigned int DEFAULT_RING_CAPACITY = 1024;
+
+  // The capacity is rounded up to a power of 2
+  explicit AsyncLogListener(
+      unsigned int ringCapacity = DEFAULT_RING_CAPACITY);
+  ~AsyncLogListener() override;
+
+  LogResult initialize(const std::string& filename) override;
+
+  LogResult log(const std::string& message) override;
+  LogResult flush() override;
+
+ private:
+  struct Slot {
+    // Ticket of the message the slot can take (free) or holds (ticket + 1)
+    std::atomic<uint64_t> m_sequence;
+    std::string m_message;
+  };
+
+  bool tryPush_(const std::string& message);
+  bool tryPop_(std::string& batch);
+  void run_();
+  void stop_();
+
+  const uint64_t m_capacity;
+  std::unique_ptr<Slot[]> m_ring;
+  // Next ticket for the producers
+  std::atomic<uint64_t> m_head{0};
+  // Next ticket to consume, writer thread only
+  uint64_t m_tail = 0;
+  // Tickets written to the file
+  std::atomic<uint64_t> m_written{0};
+
+  std::thread m_writer;
+  std::atomic<bool> m_started{false};
+  std::atomic<bool> m_stop{false};
+  std::atomic<bool> m_failed{false};
+  std::atomic<bool> m_writerWaiting{false};
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  std::mutex m_flushMutex;
+  std::condition_variable m_flushed;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_ASYNCLOGLISTENER_H */
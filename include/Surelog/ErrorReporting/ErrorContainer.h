@@ -25,10 +25,14 @@
 #define SURELOG_ERRORCONTAINER_H
 #pragma once
 
+#include <Surelog/Common/SymbolId.h>
 #include <Surelog/ErrorReporting/Error.h>
 
-#include <set>
+#include <cstdint>
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace SURELOG {
@@ -65,10 +69,13 @@ class ErrorContainer final {
 
   void registerCmdLine(CommandLineParser* clp) { m_clp = clp; }
   void init();
+  // Duplicates are detected on the error id and locations, the message is
+  // only formatted when printed (reentrantPython applies to printing).
   Error& addError(Error& error, bool showDuplicates = false,
                   bool reentrantPython = true);
 
   const std::vector<Error>& getErrors() const { return m_errors; }
+  // Prints the errors added since the previous call
   bool printMessages(bool muteStdout = false);
   bool printMessage(Error& error, bool muteStdout = false);
   bool printStats(Stats stats, bool muteStdout = false);
@@ -84,10 +91,31 @@ class ErrorContainer final {
  private:
   ErrorContainer(const ErrorContainer& orig) = delete;
 
-  std::pair<std::string, bool> createReport_() const;
+  // Report of the errors from index "from" on
+  std::pair<std::string, bool> createReport_(size_t from) const;
   std::pair<std::string, bool> createReport_(const Error& error) const;
+  // Whether -nowarning, -noinfo or -nonote drops the error
+  bool isFiltered_(const Error& error) const;
+  bool isWaived_(const Error& error);
+  void indexWaivers_();
+  static uint64_t hash_(const Error& error);
+  static bool isSame_(const Error& lhs, const Error& rhs);
+
   std::vector<Error> m_errors;
-  std::set<std::string> m_errorSet;
+  // Hash of the id and locations of the deduplicated errors -> m_errors index
+  std::unordered_multimap<uint64_t, unsigned int> m_errorIndex;
+
+  struct IndexedWaiver {
+    unsigned int m_line;  // 0 for any line
+    SymbolId m_object;    // 0 for any object
+  };
+  // (error id, file id) -> waivers, file id 0 for the waivers of any file
+  std::map<std::pair<ErrorDefinition::ErrorType, SymbolId>,
+           std::vector<IndexedWaiver>>
+      m_waiverIndex;
+  size_t m_indexedWaivers = 0;
+  // Errors already printed (or muted) by printMessages
+  size_t m_printedErrors = 0;
 
   CommandLineParser* m_clp;
   bool m_reportedFatalErrorLogFile;
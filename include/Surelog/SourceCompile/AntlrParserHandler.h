@@ -26,7 +26,7 @@
 #pragma once
 
 namespace antlr4 {
-class ANTLRInputStream;
+class CharStream;
 class CommonTokenStream;
 
 namespace tree {
@@ -37,6 +37,7 @@ class ParseTree;
 namespace SURELOG {
 
 class AntlrParserErrorListener;
+class SV3_1aFastLexer;
 class SV3_1aLexer;
 class SV3_1aParser;
 
@@ -45,8 +46,9 @@ class AntlrParserHandler {
   AntlrParserHandler() = default;
   ~AntlrParserHandler();
 
-  antlr4::ANTLRInputStream* m_inputStream = nullptr;
+  antlr4::CharStream* m_inputStream = nullptr;
   SV3_1aLexer* m_lexer = nullptr;
+  SV3_1aFastLexer* m_fastLexer = nullptr;  // Replaces m_lexer if -fastlexer
   antlr4::CommonTokenStream* m_tokens = nullptr;
   SV3_1aParser* m_parser = nullptr;
   antlr4::tree::ParseTree* m_tree = nullptr;
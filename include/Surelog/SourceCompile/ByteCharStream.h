@@ -0,0 +1,61 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_BYTECHARSTREAM_H
+#define SURELOG_BYTECHARSTREAM_H
+#pragma once
+
+#include <CharStream.h>
+
+#include <string>
+#include <string_view>
+
+namespace SURELOG {
+
+// Drop-in replacement for antlr4::ANTLRInputStream over a byte buffer.
+// ANTLRInputStream decodes its input into a UTF-32 string (4 bytes per
+// character), our sources are ASCII (the preprocessor and ParseLibraryDef
+// blank out non-ASCII characters) so each byte is returned as is. The buffer
+// is moved in, never copied nor decoded. A leading UTF-8 byte order mark is skipped, like
+// ANTLRInputStream does.
+class ByteCharStream final : public antlr4::CharStream {
+ public:
+  explicit ByteCharStream(std::string text, std::string_view sourceName = "");
+  ByteCharStream(const ByteCharStream&) = delete;
+  ByteCharStream& operator=(const ByteCharStream&) = delete;
+
+  void consume() final;
+  size_t LA(ssize_t i) final;
+  ssize_t mark() final { return -1; }
+  void release(ssize_t /*marker*/) final {}
+  size_t index() final { return m_index; }
+  void seek(size_t index) final;
+  size_t size() final { return m_data.size(); }
+  std::string getSourceName() const final;
+
+  std::string getText(const antlr4::misc::Interval& interval) final;
+  std::string toString() const final { return std::string(m_data); }
+
+ private:
+  const std::string m_text;
+  const std::string_view m_data;  // m_text without byte order mark
+  const std::string m_sourceName;
+  size_t m_index = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_BYTECHARSTREAM_H */
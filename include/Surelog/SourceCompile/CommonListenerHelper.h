@@ -28,8 +28,9 @@
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/SourceCompile/VObjectTypes.h>
 
+#include <cstdint>
 #include <string>
-#include <map>
+#include <unordered_map>
 
 namespace antlr4 {
 class CommonTokenStream;
@@ -41,6 +42,7 @@ class ParseTree;
 
 namespace SURELOG {
 
+class DesignElement;
 class FileContent;
 class VObject;
 
@@ -87,6 +89,10 @@ class CommonListenerHelper {
 
   NodeId getObjectId(antlr4::ParserRuleContext* ctx);
 
+  // Binds a re-parsed context to the object built for the one it replaces
+  // (see SV3_1aStreamingListener)
+  void aliasContext(antlr4::tree::ParseTree* ctx, NodeId index);
+
   FileContent* getFileContent() { return m_fileContent; }
 
   virtual std::tuple<unsigned int, unsigned short, unsigned int, unsigned short>
@@ -98,17 +104,22 @@ class CommonListenerHelper {
 
  protected:
   CommonListenerHelper(FileContent* file_content,
-                       antlr4::CommonTokenStream* tokens)
-      : m_fileContent(file_content), m_tokens(tokens) {}
+                       antlr4::CommonTokenStream* tokens);
 
   // These should be *const, but they are still set in some places.
   // TODO: fix these places.
   FileContent* m_fileContent;
   antlr4::CommonTokenStream* const m_tokens;
 
-  typedef std::map<const antlr4::tree::ParseTree*, NodeId>
-      ContextToObjectMap;
-  ContextToObjectMap m_contextToObjectMap;
+  // The object index of a context is stored in its listenerData field,
+  // tagged with m_walkTag (upper 32 bits) so that a tree walked again by
+  // another helper (cached preprocessor trees) never sees stale indexes.
+  const uint64_t m_walkTag;
+
+  // Design element of a context, from its creation (enter hook) until the
+  // context's object is built (exit hook)
+  std::unordered_map<const antlr4::tree::ParseTree*, DesignElement*>
+      m_contextToElementMap;
 };
 
 }  // namespace SURELOG
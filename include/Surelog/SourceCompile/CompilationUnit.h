@@ -28,6 +28,14 @@
 #include <Surelog/Common/Containers.h>
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/Design/TimeInfo.h>
+#include <Surelog/SourceCompile/MacroStorage.h>
+#include <Surelog/SourceCompile/SymbolTable.h>
+
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace SURELOG {
 
@@ -44,46 +52,78 @@ class CompilationUnit {
   bool isInDesignElement() const { return m_inDesignElement; }
   bool isFileUnit() const { return m_fileunit; }
 
-  void registerMacroInfo(const std::string& macroName, MacroInfo* macro);
-  MacroInfo* getMacroInfo(const std::string& macroName);
+  // Macro names are interned per compilation unit: the ids below are only
+  // meaningful for this unit (files have their own symbol tables).
+  SymbolId registerMacroName(std::string_view macroName) {
+    return m_macroNames.registerSymbol(macroName);
+  }
+  SymbolId getMacroNameId(std::string_view macroName) const {
+    return m_macroNames.getId(macroName);
+  }
+  const std::string& getMacroName(SymbolId id) const {
+    return m_macroNames.getSymbol(id);
+  }
 
-  const MacroStorageRef& getMacros() const { return m_macros; }
-  void deleteMacro(const std::string& macroName);
+  void registerMacroInfo(std::string_view macroName, MacroInfo* macro);
+  void registerMacroInfo(SymbolId macroNameId, MacroInfo* macro) {
+    m_macros.insert(macroNameId, macro);
+  }
+  MacroInfo* getMacroInfo(std::string_view macroName) const;
+  MacroInfo* getMacroInfo(SymbolId macroNameId) const {
+    return m_macros.find(macroNameId);
+  }
+
+  const MacroStorage& getMacros() const { return m_macros; }
+  void deleteMacro(std::string_view macroName);
+  void deleteMacro(SymbolId macroNameId) { m_macros.erase(macroNameId); }
   void deleteAllMacros() { m_macros.clear(); }
 
   /* Following methods deal with `timescale */
+  /* The record and lookup methods are thread safe: with -mt the files
+     sharing a compilation unit are parsed in parallel */
   void setCurrentTimeInfo(SymbolId fileId);
-  std::vector<TimeInfo>& getTimeInfo() { return m_timeInfo; }
+  const std::vector<TimeInfo>& getTimeInfo() const { return m_timeInfo; }
   void recordTimeInfo(TimeInfo& info);
-  TimeInfo& getTimeInfo(SymbolId fileId, unsigned int line);
+  TimeInfo getTimeInfo(SymbolId fileId, unsigned int line);
 
   /* Following methods deal with `default_nettype */
-  std::vector<NetTypeInfo>& getDefaultNetType() { return m_defaultNetTypes; }
+  const std::vector<NetTypeInfo>& getDefaultNetType() const {
+    return m_defaultNetTypes;
+  }
   void recordDefaultNetType(NetTypeInfo& info);
   VObjectType getDefaultNetType(SymbolId fileId, unsigned int line);
 
-  NodeId generateUniqueDesignElemId() {
-    m_uniqueIdGenerator++;
-    return m_uniqueIdGenerator;
-  }
-  NodeId generateUniqueNodeId() {
-    m_uniqueNodeIdGenerator++;
-    return m_uniqueNodeIdGenerator;
-  }
+  NodeId generateUniqueDesignElemId() { return ++m_uniqueIdGenerator; }
+  NodeId generateUniqueNodeId() { return ++m_uniqueNodeIdGenerator; }
 
  private:
   const bool m_fileunit;
   bool m_inDesignElement;
 
-  MacroStorageRef m_macros;
+  SymbolTable m_macroNames;
+  MacroStorage m_macros;
+
+  // Lines of the records of a file in increasing order and, for each, the
+  // latest record (index) that applies from that line on
+  struct LineIndex {
+    std::vector<unsigned int> m_lines;
+    std::vector<unsigned int> m_records;
+  };
+  static void indexRecord_(LineIndex& index, unsigned int line,
+                           unsigned int record);
+  // Latest record applying to the line, -1 if none
+  static int findRecord_(const LineIndex& index, unsigned int line);
 
   std::vector<TimeInfo> m_timeInfo;
   std::vector<NetTypeInfo> m_defaultNetTypes;
+  std::unordered_map<SymbolId, LineIndex> m_timeInfoIndex;
+  std::unordered_map<SymbolId, LineIndex> m_defaultNetTypeIndex;
   TimeInfo m_noTimeInfo;
+  std::mutex m_infoMutex;
 
   /* Design Info helper data */
-  NodeId m_uniqueIdGenerator;
-  NodeId m_uniqueNodeIdGenerator;
+  std::atomic<NodeId> m_uniqueIdGenerator;
+  std::atomic<NodeId> m_uniqueNodeIdGenerator;
 };
 
 };  // namespace SURELOG
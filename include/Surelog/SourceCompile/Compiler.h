@@ -28,6 +28,7 @@ limitations under the License.
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/ErrorReporting/ErrorContainer.h>
 #include <Surelog/SourceCompile/CompileSourceFile.h>
+#include <Surelog/SourceCompile/ParserProfiler.h>
 #include <Surelog/SourceCompile/PreprocessFile.h>
 #include <uhdm/vpi_user.h>
 
@@ -89,6 +90,7 @@ class Compiler {
 
   vpiHandle getUhdmDesign() const { return m_uhdmDesign; }
   CompileDesign* getCompileDesign() const { return m_compileDesign; }
+  ParserProfiler& getParserProfiler() { return m_parserProfiler; }
   ErrorContainer::Stats getErrorStats() const;
   bool isLibraryFile(SymbolId id) const;
   const std::map<std::filesystem::path, std::vector<std::filesystem::path>>&
@@ -109,6 +111,9 @@ class Compiler {
   bool createMultiProcessParser_();
   bool parseinit_();
   bool pythoninit_();
+  // Restores (or saves) the DFA snapshot of the generated parsers, returns the
+  // number of DFA states restored.
+  uint64_t processDFACaches_(bool save);
   bool compileFileSet_(CompileSourceFile::Action action, bool allowMultithread,
                        std::vector<CompileSourceFile*>& container);
   bool compileOneFile_(CompileSourceFile* compileSource,
@@ -124,7 +129,6 @@ class Compiler {
   std::vector<CompileSourceFile*> m_compilersChunkFiles;
   std::vector<CompileSourceFile*> m_compilersParentFiles;
   std::vector<CompilationUnit*> m_compilationUnits;
-  std::vector<SymbolTable*> m_symbolTables;
   std::vector<ErrorContainer*> m_errorContainers;
   LibrarySet* const m_librarySet;
   ConfigSet* const m_configSet;
@@ -133,6 +137,7 @@ class Compiler {
   std::set<SymbolId> m_libraryFiles;  // -v <file>
   std::string m_text;                 // unit tests
   CompileDesign* m_compileDesign;
+  ParserProfiler m_parserProfiler;  // -profile
   std::map<std::filesystem::path, std::vector<std::filesystem::path>> ppFileMap;
 #ifdef USETBB
   tbb::task_group m_taskGroup;
@@ -0,0 +1,62 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_INCLUDEFILEINDEX_H
+#define SURELOG_INCLUDEFILEINDEX_H
+#pragma once
+
+#include <Surelog/Common/SymbolId.h>
+#include <Surelog/SourceCompile/IncludeFileInfo.h>
+
+#include <utility>
+#include <vector>
+
+namespace SURELOG {
+
+// Sorted-range index over the IncludeFileInfo records of a preprocessed
+// file. Maps a line of the preprocessor output to the file and line it
+// originates from with a binary search, instead of scanning all the records
+// for each line.
+//
+// A line belongs to the record with the highest index covering it: a POP
+// record covers all the lines from its start line on, a PUSH record covers
+// the lines up to its matching POP record.
+class IncludeFileIndex final {
+ public:
+  IncludeFileIndex() = default;
+
+  void build(const std::vector<IncludeFileInfo>& infos,
+             SymbolId defaultFileId);
+  bool empty() const { return m_ranges.empty(); }
+  void clear() { m_ranges.clear(); }
+
+  // Returns (file, line) in the original sources
+  std::pair<SymbolId, unsigned int> translate(unsigned int ppLine) const;
+
+ private:
+  struct Range {
+    unsigned int m_ppStartLine = 0;
+    SymbolId m_fileId = 0;
+    unsigned int m_sectionStartLine = 0;
+    unsigned int m_originalStartLine = 0;
+  };
+  std::vector<Range> m_ranges;  // Sorted by m_ppStartLine
+  SymbolId m_defaultFileId = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_INCLUDEFILEINDEX_H */
@@ -27,22 +27,28 @@
 
 #include <Surelog/Common/SymbolId.h>
 
-#include <map>
-#include <set>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace SURELOG {
 
+// Cycle detection in a graph built one edge at a time (macro calls).
+// A topological order of the nodes is maintained incrementally
+// (Pearce-Kelly): an edge that agrees with the order costs O(1), otherwise
+// only the nodes between its two ends in the order are visited.
 class LoopCheck {
  public:
   LoopCheck() = default;
-  ~LoopCheck();
+  ~LoopCheck() = default;
 
   void clear();
 
   // return true if new edge creates a loop
   bool addEdge(SymbolId from, SymbolId to);
 
+  // Nodes of the loop found by the last addEdge, in SymbolId order
   std::vector<SymbolId> reportLoop() const;
 
  private:
@@ -50,13 +56,40 @@ class LoopCheck {
 
   class Node {
    public:
-    Node(SymbolId objId) : m_objId(objId), m_visited(false) {}
+    explicit Node(SymbolId objId, int64_t order)
+        : m_objId(objId), m_order(order) {}
     const SymbolId m_objId;
-    std::set<Node*> m_toList;
-    bool m_visited;
+    std::vector<unsigned int> m_toList;
+    std::vector<unsigned int> m_fromList;
+    int64_t m_order;  // Position in the topological order
+    unsigned int m_visited = 0;  // Search that last reached the node
+    unsigned int m_parent = 0;   // Predecessor in the forward search
   };
 
-  std::map<SymbolId, Node*> m_nodes;
+  // Index of the node, created last in the order if new
+  unsigned int node_(SymbolId objId, bool& created);
+  // Depth first search from "to", through the nodes ordered before "from"
+  // when "bounded"; records the loop and returns true when "from" is
+  // reached.
+  bool searchForward_(unsigned int from, unsigned int to, bool bounded,
+                      std::vector<unsigned int>& reached);
+  void searchBackward_(unsigned int from, int64_t lowerBound,
+                       std::vector<unsigned int>& reached);
+  void reorder_(std::vector<unsigned int>& forward,
+                std::vector<unsigned int>& backward);
+
+  std::vector<Node> m_nodes;
+  std::unordered_map<SymbolId, unsigned int> m_index;
+  // Edges as (from index << 32 | to index)
+  std::unordered_set<uint64_t> m_edges;
+  std::vector<SymbolId> m_loop;
+  // Orders of the first and last nodes
+  int64_t m_firstOrder = 0;
+  int64_t m_lastOrder = -1;
+  unsigned int m_search = 0;
+  // Once the graph has a loop there is no topological order anymore, the
+  // later edges are checked with an unbounded search.
+  bool m_cyclic = false;
 };
 }  // namespace SURELOG
 
@@ -33,19 +33,20 @@
 
 namespace SURELOG {
 
-class MacroInfo {
+class MacroInfo final {
  public:
   MacroInfo(std::string_view name, int type, SymbolId file, unsigned int line,
             unsigned short int column,
             const std::vector<std::string>& arguments,
-            const std::vector<std::string>& tokens)
-      : m_name(name),
-        m_type(type),
-        m_file(file),
-        m_line(line),
-        m_column(column),
-        m_arguments(arguments),
-        m_tokens(tokens) {}
+            const std::vector<std::string>& tokens);
+  MacroInfo(std::string_view name, int type, SymbolId file, unsigned int line,
+            unsigned short int column,
+            const std::vector<std::string_view>& arguments,
+            const std::vector<std::string_view>& tokens);
+  // m_arguments and m_tokens point into m_text
+  MacroInfo(const MacroInfo&) = delete;
+  MacroInfo& operator=(const MacroInfo&) = delete;
+
   enum Type {
     NO_ARGS,
     WITH_ARGS,
@@ -56,8 +57,15 @@ class MacroInfo {
   const SymbolId m_file;
   const unsigned int m_line;
   const unsigned short int m_column;
-  const std::vector<std::string> m_arguments;
-  const std::vector<std::string> m_tokens;
+
+ private:
+  // Single backing buffer holding the bytes of all the arguments and tokens,
+  // one allocation per macro instead of one per token.
+  std::string m_text;
+
+ public:
+  const std::vector<std::string_view> m_arguments;
+  const std::vector<std::string_view> m_tokens;
 };
 
 };  // namespace SURELOG
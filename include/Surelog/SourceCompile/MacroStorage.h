@@ -0,0 +1,111 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_MACROSTORAGE_H
+#define SURELOG_MACROSTORAGE_H
+#pragma once
+
+#include <Surelog/Common/SymbolId.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SURELOG {
+
+class MacroInfo;
+
+// Macro definitions keyed by the interned id of the macro name (see
+// CompilationUnit::registerMacroName()). Open-addressing hash table with
+// linear probing; the slots index into a vector of entries kept in definition
+// order, which is also the iteration order.
+//
+// The storage does not own the MacroInfo objects.
+class MacroStorage final {
+ public:
+  struct Entry {
+    SymbolId m_id;
+    MacroInfo* m_macro;  // nullptr once erased
+  };
+
+  class const_iterator {
+   public:
+    const_iterator(const Entry* current, const Entry* end)
+        : m_current(current), m_end(end) {
+      skipErased_();
+    }
+    MacroInfo* operator*() const { return m_current->m_macro; }
+    SymbolId id() const { return m_current->m_id; }
+    const_iterator& operator++() {
+      ++m_current;
+      skipErased_();
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const {
+      return m_current == other.m_current;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return m_current != other.m_current;
+    }
+
+   private:
+    void skipErased_() {
+      while ((m_current != m_end) && (m_current->m_macro == nullptr))
+        ++m_current;
+    }
+    const Entry* m_current;
+    const Entry* m_end;
+  };
+
+  MacroStorage() = default;
+  MacroStorage(const MacroStorage&) = delete;
+  MacroStorage& operator=(const MacroStorage&) = delete;
+
+  MacroInfo* find(SymbolId id) const;
+
+  // Returns false, and leaves the table unchanged, if "id" is already defined.
+  bool insert(SymbolId id, MacroInfo* macro);
+
+  // Returns the macro that was removed, or nullptr.
+  MacroInfo* erase(SymbolId id);
+
+  void clear();
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+
+  const_iterator begin() const {
+    return const_iterator(m_entries.data(), m_entries.data() + m_entries.size());
+  }
+  const_iterator end() const {
+    const Entry* last = m_entries.data() + m_entries.size();
+    return const_iterator(last, last);
+  }
+
+ private:
+  static constexpr uint32_t kEmptySlot = 0;  // Slots hold entry index + 1
+
+  // Slot holding "id", or the empty slot where it would be inserted.
+  size_t findSlot_(SymbolId id) const;
+  void rehash_();
+
+  std::vector<uint32_t> m_slots;
+  std::vector<Entry> m_entries;
+  size_t m_size = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_MACROSTORAGE_H */
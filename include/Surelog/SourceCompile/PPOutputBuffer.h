@@ -0,0 +1,75 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_PPOUTPUTBUFFER_H
+#define SURELOG_PPOUTPUTBUFFER_H
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SURELOG {
+
+// Output of the preprocessor, stored as a piece table. A piece is either a
+// slice of the text appended to this buffer, or a reference to the complete
+// output buffer of an included file. Included content is therefore never
+// copied into its includer; the bytes are copied once, when the top-level
+// buffer is flattened (str()) or streamed out (write()).
+//
+// A referenced buffer must outlive, and must not be modified after being
+// appended to, the referencing buffer. Included PreprocessFile objects are
+// owned by their CompileSourceFile, which guarantees both.
+class PPOutputBuffer final {
+ public:
+  PPOutputBuffer() = default;
+  PPOutputBuffer(const PPOutputBuffer&) = delete;
+  PPOutputBuffer& operator=(const PPOutputBuffer&) = delete;
+
+  void append(std::string_view text);
+  void append(const PPOutputBuffer* buffer);
+
+  void clear();
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+  size_t lineCount() const { return m_lineCount; }
+
+  // True if the content only consists of spaces and new lines.
+  bool isBlank() const;
+
+  // Flattened content
+  std::string str() const;
+  void appendTo(std::string& result) const;
+  void write(std::ostream& stream) const;
+
+ private:
+  struct Piece {
+    size_t m_offset = 0;
+    size_t m_length = 0;
+    const PPOutputBuffer* m_buffer = nullptr;
+  };
+
+  std::vector<Piece> m_pieces;
+  std::string m_text;  // Backing store for this buffer's own pieces
+  size_t m_size = 0;
+  size_t m_lineCount = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_PPOUTPUTBUFFER_H */
@@ -26,9 +26,15 @@
 #pragma once
 
 #include <Surelog/ErrorReporting/Error.h>
+#include <Surelog/SourceCompile/IncludeFileIndex.h>
 
 #include <filesystem>
 #include <string>
+#include <vector>
+
+namespace antlr4 {
+class ParserRuleContext;
+}  // namespace antlr4
 
 namespace SURELOG {
 
@@ -97,6 +103,12 @@ class ParseFile final {
     return m_antlrParserHandler;
   }
 
+  // Frees the ANTLR state (input, lexer, tokens, parser and parse tree) and
+  // the tree shape listener of this file and of its chunks, only the
+  // FileContent is used past this point. Called at the end of parse(), or
+  // once the python listener is done when it walks the tree.
+  void releaseParserHandler();
+
   void addLineTranslationInfo(LineTranslationInfo& info) {
     m_lineTranslationVec.push_back(info);
   }
@@ -127,6 +139,10 @@ class ParseFile final {
   bool debug_AstModel;
 
   bool parseOneFile_(const std::string& fileName, unsigned int lineOffset);
+  // Resumes an SLL parse that bailed out in "failedContext": re-parses the
+  // enclosing top-level description in LL mode, then the following ones
+  // SLL-first. Returns false if the failure is not inside a description.
+  bool resumeAfterSLLFailure_(antlr4::ParserRuleContext* failedContext);
   void buildLineInfoCache_();
   // For file chunk:
   std::vector<ParseFile*> m_children;
@@ -135,9 +151,9 @@ class ParseFile final {
   SymbolTable* const m_symbolTable;
   ErrorContainer* const m_errors;
   std::string m_profileInfo;
+  std::vector<unsigned int> m_sllFallbackLines;
   std::string m_sourceText;  // For Unit tests
-  std::vector<unsigned int> lineInfoCache;
-  std::vector<SymbolId> fileInfoCache;
+  IncludeFileIndex m_includeFileIndex;
 };
 
 };  // namespace SURELOG
@@ -0,0 +1,90 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_PARSERPROFILER_H
+#define SURELOG_PARSERPROFILER_H
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace antlr4 {
+class Parser;
+namespace atn {
+class DecisionInfo;
+}
+}  // namespace antlr4
+
+namespace SURELOG {
+
+// Grammar profile (-profile): the ANTLR decision statistics of every file
+// parsed, summed per grammar decision across files and threads. Reported
+// in JSON and CSV, decisions sorted by time spent in prediction.
+class ParserProfiler final {
+ public:
+  struct Decision {
+    std::string m_rule;
+    uint64_t m_files = 0;  // Number of parses the decision was invoked in
+    uint64_t m_invocations = 0;
+    uint64_t m_timeInPrediction = 0;  // Nanoseconds
+    uint64_t m_sllTotalLook = 0;
+    uint64_t m_sllMaxLook = 0;
+    uint64_t m_sllATNTransitions = 0;
+    uint64_t m_sllDFATransitions = 0;
+    uint64_t m_llFallback = 0;
+    uint64_t m_llTotalLook = 0;
+    uint64_t m_llMaxLook = 0;
+    uint64_t m_llATNTransitions = 0;
+    uint64_t m_llDFATransitions = 0;
+    uint64_t m_ambiguities = 0;
+    uint64_t m_contextSensitivities = 0;
+    uint64_t m_errors = 0;
+    uint64_t m_predicateEvals = 0;
+  };
+
+  ParserProfiler() = default;
+  ParserProfiler(const ParserProfiler&) = delete;
+  ParserProfiler& operator=(const ParserProfiler&) = delete;
+
+  // Adds the statistics of a parser with profiling enabled
+  // (Parser::setProfile(true)), thread safe.
+  void record(antlr4::Parser* parser);
+  void record(std::string_view rule, const antlr4::atn::DecisionInfo& info);
+
+  bool empty() const;
+
+  std::string toJSON() const;
+  std::string toCSV() const;
+
+  // Writes the JSON or CSV report depending on the file extension
+  bool write(const std::filesystem::path& fileName) const;
+
+ private:
+  std::vector<std::pair<size_t, Decision>> sortedDecisions_() const;
+
+  mutable std::mutex m_mutex;
+  std::map<size_t, Decision> m_decisions;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_PARSERPROFILER_H */
@@ -29,13 +29,16 @@
 #include <Surelog/Common/SymbolId.h>
 #include <Surelog/SourceCompile/IncludeFileInfo.h>
 #include <Surelog/SourceCompile/LoopCheck.h>
+#include <Surelog/SourceCompile/MacroStorage.h>
+#include <Surelog/SourceCompile/PPOutputBuffer.h>
 
 #include <filesystem>
 #include <set>
+#include <string_view>
 #include <vector>
 
 namespace antlr4 {
-class ANTLRInputStream;
+class CharStream;
 class CommonTokenStream;
 namespace tree {
 class ParseTree;
@@ -89,16 +92,18 @@ class PreprocessFile {
   /* Main function */
   bool preprocess();
   std::string getPreProcessedFileContent();
+  // Same content, without flattening it into a string
+  const PPOutputBuffer& getPreProcessedOutput();
 
   /* Macro manipulations */
   void recordMacro(const std::string& name, unsigned int line,
                    unsigned short int column,
                    const std::string& formal_arguments,
                    const std::vector<std::string>& body);
-  void recordMacro(const std::string& name, unsigned int line,
+  void recordMacro(std::string_view name, unsigned int line,
                    unsigned short int column,
-                   const std::vector<std::string>& formal_arguments,
-                   const std::vector<std::string>& body);
+                   const std::vector<std::string_view>& formal_arguments,
+                   const std::vector<std::string_view>& body);
   std::string getMacro(const std::string& name,
                        std::vector<std::string>& actual_arguments,
                        PreprocessFile* callingFile, unsigned int callingLine,
@@ -162,7 +167,7 @@ class PreprocessFile {
  private:
   SymbolId m_fileId;
   Library* m_library = nullptr;
-  std::string m_result;
+  PPOutputBuffer m_result;
   std::string m_macroBody;
   PreprocessFile* m_includer = nullptr;
   unsigned int m_includerLine = 0;
@@ -255,7 +260,7 @@ class PreprocessFile {
   struct AntlrParserHandler final {
     AntlrParserHandler() = default;
     ~AntlrParserHandler();
-    antlr4::ANTLRInputStream* m_inputStream = nullptr;
+    antlr4::CharStream* m_inputStream = nullptr;
     SV3_1aPpLexer* m_pplexer = nullptr;
     antlr4::CommonTokenStream* m_pptokens = nullptr;
     SV3_1aPpParser* m_ppparser = nullptr;
@@ -278,6 +283,8 @@ class PreprocessFile {
 
   /* To create the preprocessed content */
   void append(const std::string& s);
+  // References the output of an included file, does not copy it
+  void append(const PPOutputBuffer& included);
   void pauseAppend() { m_pauseAppend = true; }
   void resumeAppend() { m_pauseAppend = false; }
 
@@ -325,6 +332,14 @@ class PreprocessFile {
                             const std::vector<std::string>& arguments,
                             const std::vector<std::string>& tokens);
   void forgetPreprocessor_(PreprocessFile*, PreprocessFile* pp);
+  // Last design element keyword (module, endmodule...) of a content
+  enum class DesignElementKeyword { None, Begin, End };
+  // Content without any directive, macro usage or construct rewritten by
+  // the preprocessor: produce the result without the preprocessor grammar.
+  static bool isDirectiveFree_(std::string_view text, bool keepComments,
+                               DesignElementKeyword* lastKeyword);
+  void preprocessDirectiveFree_(std::string_view text,
+                                DesignElementKeyword lastKeyword);
   AntlrParserHandler* m_antlrParserHandler = nullptr;
 
   /* Only used when preprocessing a macro content */
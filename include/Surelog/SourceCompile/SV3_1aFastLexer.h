@@ -0,0 +1,107 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_SV3_1AFASTLEXER_H
+#define SURELOG_SV3_1AFASTLEXER_H
+#pragma once
+
+#include <TokenSource.h>
+#include <WritableToken.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace SURELOG {
+
+// Hand-written replacement for the generated SV3_1aLexer (see
+// grammar/SV3_1aLexer.g4). Produces the same token stream: same types,
+// channels, texts, lines and columns, following the ANTLR rules for
+// ambiguities (longest match first, then the rule defined first).
+//
+// The lexer owns the source text, tokens only reference it by offset and
+// length. It therefore has to outlive the token stream.
+class SV3_1aFastLexer final : public antlr4::TokenSource {
+ public:
+  class Token final : public antlr4::WritableToken {
+   public:
+    Token(SV3_1aFastLexer* source, size_t type, size_t channel, size_t start,
+          size_t length, size_t line, size_t column);
+
+    std::string getText() const final;
+    size_t getType() const final;
+    size_t getLine() const final { return m_line; }
+    size_t getCharPositionInLine() const final { return m_column; }
+    size_t getChannel() const final { return m_channel; }
+    size_t getTokenIndex() const final { return m_index; }
+    size_t getStartIndex() const final { return m_start; }
+    size_t getStopIndex() const final { return m_start + m_length - 1; }
+    antlr4::TokenSource* getTokenSource() const final { return m_source; }
+    antlr4::CharStream* getInputStream() const final { return nullptr; }
+    std::string toString() const final;
+
+    void setText(const std::string& text) final;
+    void setType(size_t ttype) final;
+    void setLine(size_t line) final { m_line = line; }
+    void setCharPositionInLine(size_t pos) final { m_column = pos; }
+    void setChannel(size_t channel) final { m_channel = channel; }
+    void setTokenIndex(size_t index) final { m_index = index; }
+
+   private:
+    SV3_1aFastLexer* const m_source;
+    std::unique_ptr<std::string> m_text;  // Only set by setText()
+    uint32_t m_start;
+    uint32_t m_length;
+    uint32_t m_line;
+    uint32_t m_column;
+    size_t m_index;
+    uint32_t m_type;
+    uint32_t m_channel;
+  };
+
+  SV3_1aFastLexer(std::string text, std::string_view sourceName);
+  SV3_1aFastLexer(const SV3_1aFastLexer&) = delete;
+  SV3_1aFastLexer& operator=(const SV3_1aFastLexer&) = delete;
+
+  // Same as SV3_1aLexer::sverilog, enables the SystemVerilog only keywords
+  bool sverilog = true;
+
+  std::unique_ptr<antlr4::Token> nextToken() final;
+  size_t getLine() const final { return m_line; }
+  size_t getCharPositionInLine() final { return m_column; }
+  antlr4::CharStream* getInputStream() final { return nullptr; }
+  std::string getSourceName() final { return m_sourceName; }
+  antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() final;
+
+  std::string_view getText(size_t start, size_t length) const {
+    return std::string_view(m_text).substr(start, length);
+  }
+
+ private:
+  // Type and length of the longest token starting at m_offset
+  size_t match_(size_t& length) const;
+
+  const std::string m_text;
+  const std::string m_sourceName;
+  size_t m_offset = 0;
+  size_t m_line = 1;
+  size_t m_column = 0;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_SV3_1AFASTLEXER_H */
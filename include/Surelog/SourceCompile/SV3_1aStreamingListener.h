@@ -0,0 +1,90 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#ifndef SURELOG_SV3_1ASTREAMINGLISTENER_H
+#define SURELOG_SV3_1ASTREAMINGLISTENER_H
+#pragma once
+
+#include <tree/ParseTreeListener.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace antlr4 {
+class Parser;
+class ParserRuleContext;
+namespace tree {
+class ParseTree;
+}
+}  // namespace antlr4
+
+namespace SURELOG {
+
+class SV3_1aTreeShapeListener;
+
+// Parse listener (-streamparse) that builds the VObjects while the file is
+// being parsed: each top-level description is walked with the tree shape
+// listener as soon as the parser exits it, then its sub-tree is deleted.
+// Only the top_level_rule, source_text and description contexts survive
+// until the end of the parse.
+//
+// The tree shape listener is not attached to the parser directly: parse
+// listeners see left-recursive rules (expressions, sequences...) in a
+// different order than a tree walk, and its hooks read the children of
+// the contexts they exit.
+class SV3_1aStreamingListener final : public antlr4::tree::ParseTreeListener {
+ public:
+  SV3_1aStreamingListener(SV3_1aTreeShapeListener* listener,
+                          antlr4::Parser* parser);
+  SV3_1aStreamingListener(const SV3_1aStreamingListener&) = delete;
+  SV3_1aStreamingListener& operator=(const SV3_1aStreamingListener&) = delete;
+
+  void visitTerminal(antlr4::tree::TerminalNode* node) final;
+  void visitErrorNode(antlr4::tree::ErrorNode* node) final;
+  void enterEveryRule(antlr4::ParserRuleContext* ctx) final;
+  void exitEveryRule(antlr4::ParserRuleContext* ctx) final;
+
+  // To be called before the parser is reset to re-parse the file from its
+  // first token. Events already forwarded to the tree shape listener are
+  // not forwarded again, their new contexts reuse the objects built.
+  void restart();
+
+  // Forwards the trailing events the parser did not trigger, when the tree
+  // was completed by hand (see ParseFile::resumeAfterSLLFailure_).
+  void finish(antlr4::ParserRuleContext* topLevel);
+
+ private:
+  struct Step {
+    size_t m_rule;  // INVALID_INDEX for terminals
+    int m_object;   // -1 when no object was built
+  };
+
+  // Records an event forwarded to the tree shape listener, or returns false
+  // when replaying one forwarded before restart()
+  bool forward_(antlr4::tree::ParseTree* tree);
+  void release_(antlr4::ParserRuleContext* ctx);
+
+  SV3_1aTreeShapeListener* const m_listener;
+  antlr4::Parser* const m_parser;
+  std::vector<Step> m_steps;
+  size_t m_replayed;
+  size_t m_trackerMark = 0;
+  bool m_exitedTopLevel = false;
+};
+
+}  // namespace SURELOG
+
+#endif /* SURELOG_SV3_1ASTREAMINGLISTENER_H */
@@ -28,7 +28,12 @@
 
 #include <Surelog/Common/SymbolId.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -38,13 +43,20 @@ namespace SURELOG {
 
 static constexpr NodeId InvalidNodeId = 969696;
 
+// Symbol interning table, safe to share between threads: the compiler
+// and every file, chunk and compile thread register into the same table so
+// SymbolIds are global. Lookups by id are lock free; registrations lock one
+// of the shards the string index is striped into, plus a short append lock
+// that hands out the next id.
 class SymbolTable {
  public:
   SymbolTable();
   ~SymbolTable();
 
-  // Unfortunately, currently the copy constructor is used in a few places.
-  SymbolTable(const SymbolTable&) = default;
+  // Copies share the filled string blocks of the original, only the last
+  // partially filled block and the index arrays are duplicated.
+  SymbolTable(const SymbolTable& other);
+  SymbolTable& operator=(const SymbolTable&) = delete;
 
   // Register given "symbol" string as a symbol and return its id.
   // If this is an existing symbol, its ID is returned, otherwise a new one
@@ -68,29 +80,53 @@ class SymbolTable {
   // accept a vector of string_views).
   std::vector<std::string> getSymbols() const;
 
+  // Number of symbols, ids are [0, size())
+  SymbolId size() const { return m_size.load(std::memory_order_acquire); }
+
   static const std::string& getBadSymbol();
   static SymbolId getBadId() { return 0; }
   static const std::string& getEmptyMacroMarker();
 
  private:
-  SymbolId m_idCounter;
-
-  // Stable allocated strings that don't change with vector reallocations.
-  //
-  // Unfortunately, since we have a copy-constructor, we also need to keep
-  // track of number of references, so we use the undesirable std::shared_ptr
-  // here; luckily we only need to worry about reference counting peformance
-  // on copy or realloc.
-  //
-  // On the plus side, now symbol strings are even stable between copies of
-  // symbol tables.
-  // TODO: change the whole system to actually deal with absl::string_view
-  // being returned as symbols, then have a block backing buffer here.
-  std::vector<std::shared_ptr<std::string>> m_id2SymbolMap;
-
-  // The key string_views point to the stable backing buffer provided in
-  // m_id2SymbolMap
-  std::unordered_map<std::string_view, SymbolId> m_symbol2IdMap;
+  static constexpr unsigned int kShardCount = 16;
+  static constexpr unsigned int kSegmentBits = 10;
+  static constexpr unsigned int kSegmentSize = 1 << kSegmentBits;
+
+  // String -> id index of a shard: open addressing with linear probing
+  // over a power of 2 array. A slot packs the low 32 bits of the string
+  // hash with id + 1, 0 is an empty slot.
+  struct Shard {
+    mutable std::shared_mutex m_mutex;
+    std::vector<uint64_t> m_slots;
+    size_t m_count = 0;
+  };
+
+  // Id -> string. The strings are constructed in place in blocks that never
+  // move; a filled block is immutable and shared by the copies of the table.
+  typedef std::array<std::string, kSegmentSize> Segment;
+  typedef std::vector<const Segment*> Directory;
+
+  static uint64_t hash_(std::string_view symbol);
+  Shard& shard_(uint64_t hash) const;
+  // Looks the symbol up in the shard, called with the shard locked
+  bool find_(const Shard& shard, std::string_view symbol, uint64_t hash,
+             SymbolId* id) const;
+  void insert_(Shard& shard, uint64_t hash, SymbolId id);
+  // Appends the string and returns its id, called with the shard locked
+  SymbolId append_(std::string_view symbol);
+  // Makes room for the segment, called with m_appendMutex locked
+  Directory* directory_(size_t segment);
+
+  std::unique_ptr<Shard[]> m_shards;
+
+  // Serializes the id allocation, the directory growth and the publication
+  std::mutex m_appendMutex;
+  // Number of readable ids, published after the string is in place
+  std::atomic<SymbolId> m_size{0};
+  std::atomic<Directory*> m_directory{nullptr};
+  // Directories replaced by a larger one stay alive for concurrent readers
+  std::vector<std::unique_ptr<Directory>> m_directories;
+  std::vector<std::shared_ptr<Segment>> m_segments;
 };
 
 };  // namespace SURELOG
@@ -126,6 +126,17 @@ class StringUtils final {
 
   static std::string unquoted(const std::string& text);
 
+  // Return the offset of the last byte with the high bit set (non-ASCII) in
+  // "text", or std::string_view::npos if the text is pure ASCII. Scans a
+  // machine word at a time.
+  static std::string_view::size_type findLastNonAscii(std::string_view text);
+
+  // Prepare raw source text for lexing, in place: remove all carriage
+  // returns (DOS line endings) and replace non-ASCII bytes with a space.
+  // Word-at-a-time scan; clean stretches are only moved, never inspected
+  // byte by byte.
+  static void sanitizeSourceText(std::string& text);
+
  private:
   StringUtils() = delete;
   StringUtils(const StringUtils& orig) = delete;
@@ -128,12 +128,9 @@ bool Cache::saveFlatbuffers(flatbuffers::FlatBufferBuilder& builder,
   return status;
 }
 
-std::pair<flatbuffers::Offset<Cache::VectorOffsetError>,
-          flatbuffers::Offset<Cache::VectorOffsetString>>
-Cache::cacheErrors(flatbuffers::FlatBufferBuilder& builder,
-                   SymbolTable& canonicalSymbols,
-                   ErrorContainer* errorContainer, SymbolTable* symbols,
-                   SymbolId subjectId) {
+flatbuffers::Offset<Cache::VectorOffsetError> Cache::cacheErrors(
+    flatbuffers::FlatBufferBuilder& builder, SymbolTable& canonicalSymbols,
+    ErrorContainer* errorContainer, SymbolTable* symbols, SymbolId subjectId) {
   const std::vector<Error>& errors = errorContainer->getErrors();
   std::vector<flatbuffers::Offset<SURELOG::CACHE::Error>> error_vec;
   for (const Error& error : errors) {
@@ -165,14 +162,20 @@ Cache::cacheErrors(flatbuffers::FlatBufferBuilder& builder,
     }
   }
 
-  /* Cache all the symbols */
-  for (const auto& s : symbols->getSymbols()) {
-    canonicalSymbols.registerSymbol(s);
-  }
+  return builder.CreateVector(error_vec);
+}
 
-  auto symbolVec = builder.CreateVectorOfStrings(canonicalSymbols.getSymbols());
-  auto errvec = builder.CreateVector(error_vec);
-  return std::make_pair(errvec, symbolVec);
+flatbuffers::Offset<Cache::VectorOffsetString> Cache::cacheSymbols(
+    flatbuffers::FlatBufferBuilder& builder,
+    const SymbolTable& canonicalSymbols) {
+  // Only the symbols used by the cached content, the symbol table is shared
+  // by all the files. Serialized straight from the table, no copy.
+  std::vector<flatbuffers::Offset<flatbuffers::String>> symbols;
+  symbols.reserve(canonicalSymbols.size());
+  for (SymbolId id = 0; id < canonicalSymbols.size(); ++id) {
+    symbols.push_back(builder.CreateString(canonicalSymbols.getSymbol(id)));
+  }
+  return builder.CreateVector(symbols);
 }
 
 void Cache::restoreErrors(const VectorOffsetError* errorsBuf,
@@ -233,7 +236,10 @@ std::vector<CACHE::VObject> Cache::cacheVObjects(FileContent* fcontent,
     uint64_t field2 = 0;
     uint64_t field3 = 0;
     uint64_t field4 = 0;
-    SymbolId name = canonicalSymbols.getId(fileTable.getSymbol(object.m_name));
+    SymbolId name =
+        canonicalSymbols.registerSymbol(fileTable.getSymbol(object.m_name));
+    SymbolId objectFileId =
+        canonicalSymbols.registerSymbol(fileTable.getSymbol(object.m_fileId));
     // clang-format off
     field1 |= 0x0000000000FFFFFF & (name);
     field1 |= 0x0000000FFF000000 & (((uint64_t)object.m_type)      << (24));
@@ -244,7 +250,7 @@ std::vector<CACHE::VObject> Cache::cacheVObjects(FileContent* fcontent,
     field2 |= 0xFFFFFF0000000000 & (((uint64_t)object.m_child)     << (12 + 28));
     field3 |= 0x000000000000000F & (((uint64_t)object.m_child)     >> (24));
     field3 |= 0x00000000FFFFFFF0 & (object.m_sibling               << (4));
-    field3 |= 0x00FFFFFF00000000 & (((uint64_t)object.m_fileId)    << (4 + 28));
+    field3 |= 0x00FFFFFF00000000 & (((uint64_t)objectFileId)       << (4 + 28));
     field3 |= 0xFF00000000000000 & (((uint64_t)object.m_line)      << (4 + 28 + 24));
     field4 |= 0x000000000000FFFF & (((uint64_t)object.m_line)      >> (8));
     field4 |= 0x000000FFFFFF0000 & (((uint64_t)object.m_endLine)   << (16));
@@ -0,0 +1,515 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/Cache/DFACache.h>
+#include <Surelog/Cache/dfa_generated.h>
+#include <Surelog/Utils/FileUtils.h>
+#include <antlr4-runtime.h>
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SURELOG {
+namespace fs = std::filesystem;
+
+using namespace antlr4;
+
+static const char FlbSchemaVersion[] = "1.0";
+
+namespace {
+std::vector<size_t> serializeATN(const atn::ATN& atn) {
+  atn::ATNSerializer serializer(const_cast<atn::ATN*>(&atn));
+  return serializer.serialize();
+}
+
+uint64_t hashATN(const std::vector<size_t>& serializedATN) {
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t value : serializedATN) {
+    hash ^= value;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+template <typename T>
+size_t sizeOf(const flatbuffers::Vector<T>* vector) {
+  return (vector == nullptr) ? 0 : vector->size();
+}
+
+// Flattens the DFA graphs, and the prediction/semantic context graphs they
+// reference, into index-based flatbuffers tables.
+class DFAWriter final {
+ public:
+  explicit DFAWriter(flatbuffers::FlatBufferBuilder& builder)
+      : m_builder(builder) {
+    // Entry 0 of both tables: PredictionContext::EMPTY, SemanticContext::NONE
+    m_contexts.push_back(DFACACHE::CreatePredictionContext(m_builder));
+    m_semanticContexts.push_back(DFACACHE::CreateSemanticContext(m_builder));
+  }
+
+  flatbuffers::Offset<DFACACHE::DFA> writeDFA(const dfa::DFA& decisionDFA,
+                                              size_t decision);
+
+  const std::vector<flatbuffers::Offset<DFACACHE::PredictionContext>>&
+  getContexts() const {
+    return m_contexts;
+  }
+  const std::vector<flatbuffers::Offset<DFACACHE::SemanticContext>>&
+  getSemanticContexts() const {
+    return m_semanticContexts;
+  }
+
+ private:
+  typedef std::unordered_map<const dfa::DFAState*, int32_t> StateIndex;
+
+  int32_t writeContext(const Ref<atn::PredictionContext>& context);
+  uint32_t writeSemanticContext(const Ref<atn::SemanticContext>& context);
+  flatbuffers::Offset<DFACACHE::DFAState> writeState(const dfa::DFAState& state,
+                                                     const StateIndex& index);
+  flatbuffers::Offset<flatbuffers::Vector<const DFACACHE::Edge*>> writeEdges(
+      const dfa::DFAState& state, const StateIndex& index);
+
+  flatbuffers::FlatBufferBuilder& m_builder;
+  std::vector<flatbuffers::Offset<DFACACHE::PredictionContext>> m_contexts;
+  std::vector<flatbuffers::Offset<DFACACHE::SemanticContext>>
+      m_semanticContexts;
+  std::unordered_map<const atn::PredictionContext*, int32_t> m_contextIndex;
+  std::unordered_map<const atn::SemanticContext*, uint32_t>
+      m_semanticContextIndex;
+};
+
+int32_t DFAWriter::writeContext(const Ref<atn::PredictionContext>& context) {
+  if (context == nullptr) return -1;
+  if ((context == atn::PredictionContext::EMPTY) ||
+      context->isType(atn::PredictionContext::EmptyPredictionContextClass)) {
+    return 0;
+  }
+  auto found = m_contextIndex.find(context.get());
+  if (found != m_contextIndex.end()) return found->second;
+
+  // Parents first, they get lower indexes
+  std::vector<int32_t> parents;
+  std::vector<uint64_t> returnStates;
+  for (size_t i = 0; i < context->size(); i++) {
+    parents.push_back(writeContext(context->getParent(i)));
+    returnStates.push_back(context->getReturnState(i));
+  }
+  const bool isArray = !context->isType(
+      atn::PredictionContext::SingletonPredictionContextClass);
+  auto parentsVector = m_builder.CreateVector(parents);
+  auto returnStatesVector = m_builder.CreateVector(returnStates);
+  m_contexts.push_back(DFACACHE::CreatePredictionContext(
+      m_builder, isArray, parentsVector, returnStatesVector));
+  const int32_t index = m_contexts.size() - 1;
+  m_contextIndex.emplace(context.get(), index);
+  return index;
+}
+
+uint32_t DFAWriter::writeSemanticContext(
+    const Ref<atn::SemanticContext>& context) {
+  if (context == atn::SemanticContext::NONE) return 0;
+  auto found = m_semanticContextIndex.find(context.get());
+  if (found != m_semanticContextIndex.end()) return found->second;
+
+  DFACACHE::SemanticContextType type = DFACACHE::SemanticContextType_PREDICATE;
+  uint64_t ruleIndex = 0;
+  uint64_t predIndex = 0;
+  bool isCtxDependent = false;
+  int32_t precedence = 0;
+  std::vector<uint32_t> operands;
+  if (context->isType(atn::SemanticContext::PrecedencePredicateClass)) {
+    type = DFACACHE::SemanticContextType_PRECEDENCE;
+    precedence =
+        static_cast<const atn::SemanticContext::PrecedencePredicate*>(
+            context.get())
+            ->precedence;
+  } else if (context->isType(atn::SemanticContext::ANDClass)) {
+    type = DFACACHE::SemanticContextType_AND;
+    for (const auto& operand :
+         static_cast<const atn::SemanticContext::AND*>(context.get())->opnds) {
+      operands.push_back(writeSemanticContext(operand));
+    }
+  } else if (context->isType(atn::SemanticContext::ORClass)) {
+    type = DFACACHE::SemanticContextType_OR;
+    for (const auto& operand :
+         static_cast<const atn::SemanticContext::OR*>(context.get())->opnds) {
+      operands.push_back(writeSemanticContext(operand));
+    }
+  } else {
+    const atn::SemanticContext::Predicate* predicate =
+        static_cast<const atn::SemanticContext::Predicate*>(context.get());
+    ruleIndex = predicate->ruleIndex;
+    predIndex = predicate->predIndex;
+    isCtxDependent = predicate->isCtxDependent;
+  }
+  auto operandsVector = m_builder.CreateVector(operands);
+  m_semanticContexts.push_back(DFACACHE::CreateSemanticContext(
+      m_builder, type, ruleIndex, predIndex, isCtxDependent, precedence,
+      operandsVector));
+  const uint32_t index = m_semanticContexts.size() - 1;
+  m_semanticContextIndex.emplace(context.get(), index);
+  return index;
+}
+
+flatbuffers::Offset<flatbuffers::Vector<const DFACACHE::Edge*>>
+DFAWriter::writeEdges(const dfa::DFAState& state, const StateIndex& index) {
+  std::vector<DFACACHE::Edge> edges;
+  for (const auto& [symbol, target] : state.edges) {
+    if (target == nullptr) continue;
+    if (target == atn::ATNSimulator::ERROR.get()) {
+      edges.emplace_back(symbol, -1);
+      continue;
+    }
+    auto found = index.find(target);
+    if (found != index.end()) edges.emplace_back(symbol, found->second);
+  }
+  std::sort(edges.begin(), edges.end(),
+            [](const DFACACHE::Edge& a, const DFACACHE::Edge& b) {
+              return a.symbol() < b.symbol();
+            });
+  return m_builder.CreateVectorOfStructs(edges);
+}
+
+flatbuffers::Offset<DFACACHE::DFAState> DFAWriter::writeState(
+    const dfa::DFAState& state, const StateIndex& index) {
+  const atn::ATNConfigSet* configSet = state.configs.get();
+  std::vector<DFACACHE::ATNConfig> configs;
+  for (const Ref<atn::ATNConfig>& config : configSet->configs) {
+    configs.emplace_back(config->state->stateNumber, config->alt,
+                         writeContext(config->context),
+                         writeSemanticContext(config->semanticContext),
+                         config->reachesIntoOuterContext);
+  }
+  std::vector<uint64_t> conflictingAlts;
+  for (size_t alt = 0; alt < configSet->conflictingAlts.size(); alt++) {
+    if (configSet->conflictingAlts.test(alt)) conflictingAlts.push_back(alt);
+  }
+  std::vector<DFACACHE::PredPrediction> predicates;
+  for (const dfa::DFAState::PredPrediction* predicate : state.predicates) {
+    predicates.emplace_back(writeSemanticContext(predicate->pred),
+                            predicate->alt);
+  }
+  auto configsVector = m_builder.CreateVectorOfStructs(configs);
+  auto conflictingAltsVector = m_builder.CreateVector(conflictingAlts);
+  auto predicatesVector = m_builder.CreateVectorOfStructs(predicates);
+  auto edgesVector = writeEdges(state, index);
+  return DFACACHE::CreateDFAState(
+      m_builder, state.stateNumber, configSet->fullCtx, configsVector,
+      configSet->uniqueAlt, conflictingAltsVector,
+      configSet->hasSemanticContext, configSet->dipsIntoOuterContext,
+      state.isAcceptState, state.prediction, state.requiresFullContext,
+      predicatesVector, edgesVector);
+}
+
+flatbuffers::Offset<DFACACHE::DFA> DFAWriter::writeDFA(
+    const dfa::DFA& decisionDFA, size_t decision) {
+  std::vector<const dfa::DFAState*> states(decisionDFA.states.begin(),
+                                           decisionDFA.states.end());
+  std::sort(states.begin(), states.end(),
+            [](const dfa::DFAState* a, const dfa::DFAState* b) {
+              return a->stateNumber < b->stateNumber;
+            });
+  StateIndex index;
+  for (size_t i = 0; i < states.size(); i++) index.emplace(states[i], i);
+
+  std::vector<flatbuffers::Offset<DFACACHE::DFAState>> stateOffsets;
+  stateOffsets.reserve(states.size());
+  for (const dfa::DFAState* state : states) {
+    stateOffsets.push_back(writeState(*state, index));
+  }
+  int32_t s0 = -1;
+  flatbuffers::Offset<flatbuffers::Vector<const DFACACHE::Edge*>>
+      precedenceEdges;
+  if (decisionDFA.isPrecedenceDfa()) {
+    // The precedence start state only holds edges to the real start states
+    if (decisionDFA.s0) precedenceEdges = writeEdges(*decisionDFA.s0, index);
+  } else if (decisionDFA.s0) {
+    auto found = index.find(decisionDFA.s0);
+    if (found != index.end()) s0 = found->second;
+  }
+  auto statesVector = m_builder.CreateVector(stateOffsets);
+  return DFACACHE::CreateDFA(m_builder, decision, statesVector, s0,
+                             precedenceEdges);
+}
+
+// DFA states of one decision, not yet handed over to the parser
+struct RestoredDFA {
+  size_t m_decision = 0;
+  std::vector<std::unique_ptr<dfa::DFAState>> m_states;
+  dfa::DFAState* m_s0 = nullptr;
+  std::vector<std::pair<size_t, dfa::DFAState*>> m_precedenceEdges;
+};
+
+dfa::DFAState* getEdgeTarget(const RestoredDFA& restored, int32_t target) {
+  if (target == -1) return atn::ATNSimulator::ERROR.get();
+  if ((target < 0) || ((size_t)target >= restored.m_states.size())) {
+    return nullptr;
+  }
+  return restored.m_states[target].get();
+}
+}  // namespace
+
+DFACache::DFACache(antlr4::Parser* parser, const fs::path& cacheDir)
+    : m_parser(parser),
+      m_cacheFileName(cacheDir /
+                      (fs::path(parser->getGrammarFileName()).stem().string() +
+                       ".sldfa")) {}
+
+bool DFACache::save() {
+  atn::ParserATNSimulator* simulator =
+      m_parser->getInterpreter<atn::ParserATNSimulator>();
+  if (simulator == nullptr) return false;
+  const std::vector<size_t> serializedATN = serializeATN(m_parser->getATN());
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto header = createHeader(builder, FlbSchemaVersion, m_cacheFileName);
+  auto grammar = builder.CreateString(m_parser->getGrammarFileName());
+
+  DFAWriter writer(builder);
+  std::vector<flatbuffers::Offset<DFACACHE::DFA>> dfas;
+  for (size_t decision = 0; decision < simulator->decisionToDFA.size();
+       decision++) {
+    const dfa::DFA& decisionDFA = simulator->decisionToDFA[decision];
+    if (decisionDFA.states.empty()) continue;
+    dfas.push_back(writer.writeDFA(decisionDFA, decision));
+  }
+  auto contexts = builder.CreateVector(writer.getContexts());
+  auto semanticContexts = builder.CreateVector(writer.getSemanticContexts());
+  auto dfaVector = builder.CreateVector(dfas);
+  auto dfaCache = DFACACHE::CreateDFACache(
+      builder, header, grammar, serializedATN.size(), hashATN(serializedATN),
+      contexts, semanticContexts, dfaVector);
+  FinishDFACacheBuffer(builder, dfaCache);
+
+  FileUtils::mkDirs(m_cacheFileName.parent_path());
+  return saveFlatbuffers(builder, m_cacheFileName);
+}
+
+bool DFACache::restore() {
+  m_nbRestoredStates = 0;
+  uint8_t* const buffer_pointer = openFlatBuffers(m_cacheFileName);
+  if (buffer_pointer == nullptr) return false;
+  const bool status = restore_(buffer_pointer);
+  delete[] buffer_pointer;
+  return status;
+}
+
+bool DFACache::restore_(const uint8_t* buffer) {
+  if (!DFACACHE::DFACacheBufferHasIdentifier(buffer)) return false;
+  const DFACACHE::DFACache* cache = DFACACHE::GetDFACache(buffer);
+
+  /* Schema and grammar check: the DFA is only valid for the exact ATN */
+  const CACHE::Header* header = cache->header();
+  if ((header == nullptr) || (header->flb_version() == nullptr) ||
+      (std::string_view(header->flb_version()->c_str()) != FlbSchemaVersion)) {
+    return false;
+  }
+  if ((cache->grammar() == nullptr) ||
+      (cache->grammar()->str() != m_parser->getGrammarFileName())) {
+    return false;
+  }
+  const atn::ATN& atn = m_parser->getATN();
+  const std::vector<size_t> serializedATN = serializeATN(atn);
+  if ((cache->atn_size() != serializedATN.size()) ||
+      (cache->atn_hash() != hashATN(serializedATN))) {
+    return false;
+  }
+  atn::ParserATNSimulator* simulator =
+      m_parser->getInterpreter<atn::ParserATNSimulator>();
+  if (simulator == nullptr) return false;
+  std::vector<dfa::DFA>& decisionToDFA = simulator->decisionToDFA;
+
+  /* Prediction contexts, parents always precede their children */
+  std::vector<Ref<atn::PredictionContext>> contexts;
+  for (size_t i = 0; i < sizeOf(cache->prediction_contexts()); i++) {
+    if (i == 0) {
+      contexts.push_back(atn::PredictionContext::EMPTY);
+      continue;
+    }
+    const DFACACHE::PredictionContext* context =
+        cache->prediction_contexts()->Get(i);
+    const size_t size = sizeOf(context->parents());
+    if ((size == 0) || (size != sizeOf(context->return_states()))) {
+      return false;
+    }
+    std::vector<Ref<atn::PredictionContext>> parents;
+    std::vector<size_t> returnStates;
+    for (size_t j = 0; j < size; j++) {
+      const int32_t parent = context->parents()->Get(j);
+      if ((parent < -1) || (parent >= (int32_t)contexts.size())) return false;
+      parents.push_back((parent == -1) ? nullptr : contexts[parent]);
+      returnStates.push_back(context->return_states()->Get(j));
+    }
+    if (context->is_array()) {
+      contexts.push_back(
+          std::make_shared<atn::ArrayPredictionContext>(parents, returnStates));
+    } else {
+      if (size != 1) return false;
+      contexts.push_back(
+          atn::SingletonPredictionContext::create(parents[0], returnStates[0]));
+    }
+  }
+
+  /* Semantic contexts, operands always precede their operator */
+  std::vector<Ref<atn::SemanticContext>> semanticContexts;
+  for (size_t i = 0; i < sizeOf(cache->semantic_contexts()); i++) {
+    if (i == 0) {
+      semanticContexts.push_back(atn::SemanticContext::NONE);
+      continue;
+    }
+    const DFACACHE::SemanticContext* context =
+        cache->semantic_contexts()->Get(i);
+    std::vector<Ref<atn::SemanticContext>> operands;
+    for (size_t j = 0; j < sizeOf(context->operands()); j++) {
+      const uint32_t operand = context->operands()->Get(j);
+      if (operand >= semanticContexts.size()) return false;
+      operands.push_back(semanticContexts[operand]);
+    }
+    switch (context->type()) {
+      case DFACACHE::SemanticContextType_PREDICATE:
+        semanticContexts.push_back(
+            std::make_shared<atn::SemanticContext::Predicate>(
+                context->rule_index(), context->pred_index(),
+                context->is_ctx_dependent()));
+        break;
+      case DFACACHE::SemanticContextType_PRECEDENCE:
+        semanticContexts.push_back(
+            std::make_shared<atn::SemanticContext::PrecedencePredicate>(
+                context->precedence()));
+        break;
+      case DFACACHE::SemanticContextType_AND: {
+        auto andContext = std::make_shared<atn::SemanticContext::AND>();
+        andContext->opnds = operands;
+        semanticContexts.push_back(andContext);
+        break;
+      }
+      case DFACACHE::SemanticContextType_OR: {
+        auto orContext = std::make_shared<atn::SemanticContext::OR>();
+        orContext->opnds = operands;
+        semanticContexts.push_back(orContext);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  /* DFA states. Nothing is handed to the parser before everything decoded */
+  std::vector<RestoredDFA> restoredDFAs;
+  for (size_t i = 0; i < sizeOf(cache->dfas()); i++) {
+    const DFACACHE::DFA* cachedDFA = cache->dfas()->Get(i);
+    if (cachedDFA->decision() >= decisionToDFA.size()) return false;
+    RestoredDFA restored;
+    restored.m_decision = cachedDFA->decision();
+    for (size_t j = 0; j < sizeOf(cachedDFA->states()); j++) {
+      const DFACACHE::DFAState* state = cachedDFA->states()->Get(j);
+      auto configSet = std::make_unique<atn::ATNConfigSet>(state->full_ctx());
+      for (size_t k = 0; k < sizeOf(state->configs()); k++) {
+        const DFACACHE::ATNConfig* config = state->configs()->Get(k);
+        if ((config->state() >= atn.states.size()) ||
+            (config->context() >= contexts.size()) ||
+            (config->semantic_context() >= semanticContexts.size())) {
+          return false;
+        }
+        auto atnConfig = std::make_shared<atn::ATNConfig>(
+            atn.states[config->state()], config->alt(),
+            contexts[config->context()],
+            semanticContexts[config->semantic_context()]);
+        atnConfig->reachesIntoOuterContext =
+            config->reaches_into_outer_context();
+        configSet->add(atnConfig);
+      }
+      configSet->uniqueAlt = state->unique_alt();
+      configSet->conflictingAlts.reset();
+      for (size_t k = 0; k < sizeOf(state->conflicting_alts()); k++) {
+        const uint64_t alt = state->conflicting_alts()->Get(k);
+        if (alt >= configSet->conflictingAlts.size()) return false;
+        configSet->conflictingAlts.set(alt);
+      }
+      configSet->hasSemanticContext = state->has_semantic_context();
+      configSet->dipsIntoOuterContext = state->dips_into_outer_context();
+      // Same as ParserATNSimulator::addDFAState()
+      configSet->optimizeConfigs(simulator);
+      configSet->setReadonly(true);
+
+      auto dfaState = std::make_unique<dfa::DFAState>(std::move(configSet));
+      dfaState->stateNumber = state->state_number();
+      dfaState->isAcceptState = state->is_accept_state();
+      dfaState->prediction = state->prediction();
+      dfaState->requiresFullContext = state->requires_full_context();
+      for (size_t k = 0; k < sizeOf(state->predicates()); k++) {
+        const DFACACHE::PredPrediction* predicate =
+            state->predicates()->Get(k);
+        if (predicate->semantic_context() >= semanticContexts.size()) {
+          return false;
+        }
+        dfaState->predicates.push_back(new dfa::DFAState::PredPrediction(
+            semanticContexts[predicate->semantic_context()],
+            predicate->alt()));
+      }
+      restored.m_states.push_back(std::move(dfaState));
+    }
+    for (size_t j = 0; j < sizeOf(cachedDFA->states()); j++) {
+      const DFACACHE::DFAState* state = cachedDFA->states()->Get(j);
+      for (size_t k = 0; k < sizeOf(state->edges()); k++) {
+        const DFACACHE::Edge* edge = state->edges()->Get(k);
+        dfa::DFAState* target = getEdgeTarget(restored, edge->target());
+        if (target == nullptr) return false;
+        restored.m_states[j]->edges[edge->symbol()] = target;
+      }
+    }
+    if (cachedDFA->s0() != -1) {
+      restored.m_s0 = getEdgeTarget(restored, cachedDFA->s0());
+      if ((restored.m_s0 == nullptr) ||
+          (restored.m_s0 == atn::ATNSimulator::ERROR.get())) {
+        return false;
+      }
+    }
+    for (size_t k = 0; k < sizeOf(cachedDFA->precedence_edges()); k++) {
+      const DFACACHE::Edge* edge = cachedDFA->precedence_edges()->Get(k);
+      dfa::DFAState* target = getEdgeTarget(restored, edge->target());
+      if (target == nullptr) return false;
+      restored.m_precedenceEdges.emplace_back(edge->symbol(), target);
+    }
+    restoredDFAs.push_back(std::move(restored));
+  }
+
+  /* Hand the states over, to the decisions that have not been used yet */
+  for (RestoredDFA& restored : restoredDFAs) {
+    dfa::DFA& decisionDFA = decisionToDFA[restored.m_decision];
+    if (!decisionDFA.states.empty()) continue;
+    if (decisionDFA.isPrecedenceDfa()) {
+      if (restored.m_s0 != nullptr) continue;
+      for (const auto& [precedence, target] : restored.m_precedenceEdges) {
+        decisionDFA.s0->edges[precedence] = target;
+      }
+    } else {
+      if (!restored.m_precedenceEdges.empty()) continue;
+      decisionDFA.s0 = restored.m_s0;
+    }
+    m_nbRestoredStates += restored.m_states.size();
+    for (std::unique_ptr<dfa::DFAState>& state : restored.m_states) {
+      decisionDFA.states.insert(state.release());
+    }
+  }
+  return true;
+}
+
+}  // namespace SURELOG
@@ -0,0 +1,201 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/Cache/DFACache.h>
+#include <Surelog/Design/FileContent.h>
+#include <Surelog/SourceCompile/ParserHarness.h>
+#include <Surelog/Utils/Timer.h>
+#include <antlr4-runtime.h>
+#include <gtest/gtest.h>
+#include <parser/SV3_1aLexer.h>
+#include <parser/SV3_1aParser.h>
+#include <parser/SV3_1aPpLexer.h>
+#include <parser/SV3_1aPpParser.h>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr char kContent[] = R"(
+module top(input logic [7:0] a, b, output logic [7:0] c);
+  always_comb begin
+    c = (a + b) * 2 - (a >> 1);
+    if (a[0] && !b[1]) c = a | b;
+  end
+endmodule
+)";
+
+// States of every decision of the parser's (static) prediction DFAs
+std::vector<size_t> countStates(antlr4::Parser* parser) {
+  std::vector<size_t> counts;
+  for (const antlr4::dfa::DFA& decisionDFA :
+       parser->getInterpreter<antlr4::atn::ParserATNSimulator>()
+           ->decisionToDFA) {
+    counts.push_back(decisionDFA.states.size());
+  }
+  return counts;
+}
+
+size_t sum(const std::vector<size_t>& counts) {
+  size_t total = 0;
+  for (size_t count : counts) total += count;
+  return total;
+}
+
+// A cache directory of its own for each test, ctest may run them in parallel
+fs::path testCacheDir() {
+  const ::testing::TestInfo* info =
+      ::testing::UnitTest::GetInstance()->current_test_info();
+  return fs::temp_directory_path() /
+         (std::string("surelog_dfa_") + info->name());
+}
+
+TEST(DFACacheTest, SaveAndRestore) {
+  const fs::path cacheDir = testCacheDir();
+  fs::remove_all(cacheDir);
+
+  ParserHarness harness;
+  auto before = harness.parse(kContent);
+  ASSERT_NE(before, nullptr);
+  const std::string objects = before->printObjects();
+
+  antlr4::ANTLRInputStream input;
+  SV3_1aLexer lexer(&input);
+  antlr4::CommonTokenStream tokens(&lexer);
+  SV3_1aParser parser(&tokens);
+  const std::vector<size_t> trained = countStates(&parser);
+  ASSERT_GT(sum(trained), 0);
+
+  DFACache cache(&parser, cacheDir);
+  ASSERT_TRUE(cache.save());
+
+  parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->clearDFA();
+  EXPECT_EQ(sum(countStates(&parser)), 0);
+  ASSERT_TRUE(cache.restore());
+  EXPECT_EQ(cache.getNbRestoredStates(), sum(trained));
+  EXPECT_EQ(countStates(&parser), trained);
+
+  // Decisions already trained are left alone
+  ASSERT_TRUE(cache.restore());
+  EXPECT_EQ(cache.getNbRestoredStates(), 0);
+
+  // The restored DFA predicts as the trained one did
+  auto after = harness.parse(kContent);
+  ASSERT_NE(after, nullptr);
+  EXPECT_EQ(after->printObjects(), objects);
+  EXPECT_EQ(countStates(&parser), trained);
+
+  fs::remove_all(cacheDir);
+}
+
+TEST(DFACacheTest, RejectsOtherGrammar) {
+  const fs::path cacheDir = testCacheDir();
+  fs::remove_all(cacheDir);
+
+  ParserHarness harness;
+  ASSERT_NE(harness.parse(kContent), nullptr);
+
+  antlr4::ANTLRInputStream input;
+  SV3_1aLexer lexer(&input);
+  antlr4::CommonTokenStream tokens(&lexer);
+  SV3_1aParser parser(&tokens);
+  SV3_1aPpLexer ppLexer(&input);
+  antlr4::CommonTokenStream ppTokens(&ppLexer);
+  SV3_1aPpParser ppParser(&ppTokens);
+
+  DFACache cache(&parser, cacheDir);
+  ASSERT_TRUE(cache.save());
+  // Snapshot of the SV parser under the name of the preprocessor's
+  const std::string ppName =
+      fs::path(ppParser.getGrammarFileName()).stem().string() + ".sldfa";
+  const std::string svName =
+      fs::path(parser.getGrammarFileName()).stem().string() + ".sldfa";
+  fs::copy_file(cacheDir / svName, cacheDir / ppName);
+
+  const std::vector<size_t> ppStates = countStates(&ppParser);
+  DFACache ppCache(&ppParser, cacheDir);
+  EXPECT_FALSE(ppCache.restore());
+  EXPECT_EQ(ppCache.getNbRestoredStates(), 0);
+  EXPECT_EQ(countStates(&ppParser), ppStates);
+
+  // Missing snapshot
+  fs::remove_all(cacheDir);
+  EXPECT_FALSE(cache.restore());
+
+  fs::remove_all(cacheDir);
+}
+
+// Time to parse a file in a fresh process, with empty DFAs, then after a
+// restore. The times are reported, not checked: the deterministic part is that
+// a restored DFA needs no new state to parse the training input again.
+TEST(DFACacheTest, TimeToFirstParse) {
+  const fs::path cacheDir = testCacheDir();
+  fs::remove_all(cacheDir);
+
+  antlr4::ANTLRInputStream input;
+  SV3_1aLexer lexer(&input);
+  antlr4::CommonTokenStream tokens(&lexer);
+  SV3_1aParser parser(&tokens);
+  SV3_1aPpLexer ppLexer(&input);
+  antlr4::CommonTokenStream ppTokens(&ppLexer);
+  SV3_1aPpParser ppParser(&ppTokens);
+  const std::vector<antlr4::Parser*> parsers = {&parser, &ppParser};
+  auto clearDFAs = [&parsers]() {
+    for (antlr4::Parser* recognizer : parsers) {
+      recognizer->getInterpreter<antlr4::atn::ParserATNSimulator>()
+          ->clearDFA();
+    }
+  };
+
+  ParserHarness harness;
+  clearDFAs();
+  Timer tmr;
+  ASSERT_NE(harness.parse(kContent), nullptr);
+  const double coldTime = tmr.elapsed();
+  const std::vector<size_t> trained = countStates(&parser);
+  ASSERT_GT(sum(trained), 0);
+  for (antlr4::Parser* recognizer : parsers) {
+    ASSERT_TRUE(DFACache(recognizer, cacheDir).save());
+  }
+
+  clearDFAs();
+  tmr.reset();
+  for (antlr4::Parser* recognizer : parsers) {
+    ASSERT_TRUE(DFACache(recognizer, cacheDir).restore());
+  }
+  const double restoreTime = tmr.elapsed();
+  tmr.reset();
+  ASSERT_NE(harness.parse(kContent), nullptr);
+  const double warmTime = tmr.elapsed();
+  EXPECT_EQ(countStates(&parser), trained);
+
+  std::cout << "Time to first parse: " << coldTime * 1000 << "ms cold, "
+            << warmTime * 1000 << "ms after a " << restoreTime * 1000
+            << "ms restore of " << sum(trained) << " SV states" << std::endl;
+  RecordProperty("cold_ms", static_cast<int>(coldTime * 1000));
+  RecordProperty("restore_ms", static_cast<int>(restoreTime * 1000));
+  RecordProperty("warm_ms", static_cast<int>(warmTime * 1000));
+
+  fs::remove_all(cacheDir);
+}
+}  // namespace
+}  // namespace SURELOG
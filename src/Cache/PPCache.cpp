@@ -42,7 +42,7 @@ namespace fs = std::filesystem;
 
 PPCache::PPCache(PreprocessFile* pp) : m_pp(pp), m_isPrecompiled(false) {}
 
-static const char FlbSchemaVersion[] = "1.0";
+static const char FlbSchemaVersion[] = "1.1";
 
 fs::path PPCache::getCacheFileName_(const fs::path& requested_file) {
   Precompiled* prec = Precompiled::getSingleton();
@@ -86,6 +86,19 @@ fs::path PPCache::getCacheFileName_(const fs::path& requested_file) {
   return cacheFileName;
 }
 
+// CreateVectorOfStrings() only accepts std::string elements
+static flatbuffers::Offset<
+    flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+createVectorOfStrings(flatbuffers::FlatBufferBuilder& builder,
+                      const std::vector<std::string_view>& strings) {
+  std::vector<flatbuffers::Offset<flatbuffers::String>> offsets;
+  offsets.reserve(strings.size());
+  for (std::string_view s : strings) {
+    offsets.push_back(builder.CreateString(s.data(), s.size()));
+  }
+  return builder.CreateVector(offsets);
+}
+
 template <class T>
 static bool compareVectors(std::vector<T> a, std::vector<T> b) {
   std::sort(a.begin(), a.end());
@@ -103,16 +116,20 @@ bool PPCache::restore_(const fs::path& cacheFileName, bool errorsOnly) {
         ppcache->macros();
     for (unsigned int i = 0; i < macros->size(); i++) {
       const MACROCACHE::Macro* macro = macros->Get(i);
-      std::vector<std::string> args;
-      std::vector<std::string> tokens;
-      for (unsigned int j = 0; j < macro->arguments()->size(); j++) {
-        args.push_back(macro->arguments()->Get(j)->str());
+      // Views into the cache buffer, the MacroInfo copies them in one block
+      std::vector<std::string_view> args;
+      std::vector<std::string_view> tokens;
+      args.reserve(macro->arguments()->size());
+      tokens.reserve(macro->tokens()->size());
+      for (const flatbuffers::String* arg : *macro->arguments()) {
+        args.emplace_back(arg->c_str(), arg->size());
       }
-      for (unsigned int j = 0; j < macro->tokens()->size(); j++) {
-        tokens.push_back(macro->tokens()->Get(j)->str());
+      for (const flatbuffers::String* token : *macro->tokens()) {
+        tokens.emplace_back(token->c_str(), token->size());
       }
-      m_pp->recordMacro(macro->name()->str(), macro->line(), macro->column(),
-                        args, tokens);
+      m_pp->recordMacro(
+          std::string_view(macro->name()->c_str(), macro->name()->size()),
+          macro->line(), macro->column(), args, tokens);
     }
   }
   SymbolTable canonicalSymbols;
@@ -336,16 +353,12 @@ bool PPCache::save() {
   /* Cache the macro definitions */
   const MacroStorage& macros = m_pp->getMacros();
   std::vector<flatbuffers::Offset<MACROCACHE::Macro>> macro_vec;
-  for (MacroStorage::const_iterator itr = macros.begin(); itr != macros.end();
-       itr++) {
-    std::string macroName = (*itr).first;
-    MacroInfo* info = (*itr).second;
-
-    auto name = builder.CreateString(macroName);
+  for (MacroInfo* info : macros) {
+    auto name = builder.CreateString(info->m_name);
     MACROCACHE::MacroType type = (info->m_type == MacroInfo::WITH_ARGS)
                                      ? MACROCACHE::MacroType_WITH_ARGS
                                      : MACROCACHE::MacroType_NO_ARGS;
-    auto args = builder.CreateVectorOfStrings(info->m_arguments);
+    auto args = createVectorOfStrings(builder, info->m_arguments);
     /*
     Debug code for a flatbuffer issue"
     std::cout << "STRING VECTOR CONTENT:\n";
@@ -357,7 +370,7 @@ bool PPCache::save() {
       index++;
     }
     */
-    auto tokens = builder.CreateVectorOfStrings(info->m_tokens);
+    auto tokens = createVectorOfStrings(builder, info->m_tokens);
     macro_vec.push_back(MACROCACHE::CreateMacro(
         builder, name, type, info->m_line, info->m_column, args, tokens));
   }
@@ -381,7 +394,7 @@ bool PPCache::save() {
       m_pp->getCompileSourceFile()->getErrorContainer();
   SymbolId subjectFileId = m_pp->getFileId(LINE1);
   SymbolTable canonicalSymbols;
-  auto errorSymbolPair = cacheErrors(
+  auto errorList = cacheErrors(
       builder, canonicalSymbols, errorContainer,
       m_pp->getCompileSourceFile()->getSymbolTable(), subjectFileId);
 
@@ -413,7 +426,7 @@ bool PPCache::save() {
     if (info.m_fileId != m_pp->getFileId(0)) continue;
     auto timeInfo = CACHE::CreateTimeInfo(
         builder, static_cast<uint16_t>(info.m_type),
-        canonicalSymbols.getId(
+        canonicalSymbols.registerSymbol(
             m_pp->getCompileSourceFile()->getSymbolTable()->getSymbol(
                 info.m_fileId)),
         info.m_line, static_cast<uint16_t>(info.m_timeUnit),
@@ -463,12 +476,13 @@ bool PPCache::save() {
       fcontent, canonicalSymbols,
       *m_pp->getCompileSourceFile()->getSymbolTable(), m_pp->getFileId(0));
   auto objectList = builder.CreateVectorOfStructs(object_vec);
+  auto symbolList = cacheSymbols(builder, canonicalSymbols);
 
   /* Create Flatbuffers */
   auto ppcache = MACROCACHE::CreatePPCache(
-      builder, header, macroList, includeList, body, errorSymbolPair.first,
-      errorSymbolPair.second, incPaths, defines, timeinfoFBList, lineinfoFBList,
-      incinfoFBList, objectList);
+      builder, header, macroList, includeList, body, errorList, symbolList,
+      incPaths, defines, timeinfoFBList, lineinfoFBList, incinfoFBList,
+      objectList);
   FinishPPCacheBuffer(builder, ppcache);
 
   /* Save Flatbuffer */
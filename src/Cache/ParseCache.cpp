@@ -41,7 +41,7 @@ namespace fs = std::filesystem;
 ParseCache::ParseCache(ParseFile* parser)
     : m_parse(parser), m_isPrecompiled(false) {}
 
-static constexpr char FlbSchemaVersion[] = "1.0";
+static constexpr char FlbSchemaVersion[] = "1.1";
 
 fs::path ParseCache::getCacheFileName_(const fs::path& svFileNameIn) {
   fs::path svFileName = svFileNameIn;
@@ -227,7 +227,7 @@ bool ParseCache::save() {
       m_parse->getCompileSourceFile()->getSymbolTable()->registerSymbol(
           subjectFile.string());
   SymbolTable canonicalSymbols;
-  auto errorSymbolPair = cacheErrors(
+  auto errorList = cacheErrors(
       builder, canonicalSymbols, errorContainer,
       m_parse->getCompileSourceFile()->getSymbolTable(), subjectFileId);
 
@@ -242,15 +242,15 @@ bool ParseCache::save() {
               elem->m_name);
       auto timeInfo = CACHE::CreateTimeInfo(
           builder, static_cast<uint16_t>(info.m_type),
-          canonicalSymbols.getId(
+          canonicalSymbols.registerSymbol(
               m_parse->getCompileSourceFile()->getSymbolTable()->getSymbol(
                   info.m_fileId)),
           info.m_line, static_cast<uint16_t>(info.m_timeUnit),
           info.m_timeUnitValue, static_cast<uint16_t>(info.m_timePrecision),
           info.m_timePrecisionValue);
       element_vec.push_back(PARSECACHE::CreateDesignElement(
-          builder, canonicalSymbols.getId(elemName),
-          canonicalSymbols.getId(
+          builder, canonicalSymbols.registerSymbol(elemName),
+          canonicalSymbols.registerSymbol(
               m_parse->getCompileSourceFile()->getSymbolTable()->getSymbol(
                   elem->m_fileId)),
           elem->m_type, elem->m_uniqueId, elem->m_line, elem->m_column,
@@ -265,11 +265,11 @@ bool ParseCache::save() {
                     *m_parse->getCompileSourceFile()->getSymbolTable(),
                     m_parse->getFileId(0));
   auto objectList = builder.CreateVectorOfStructs(object_vec);
+  auto symbolList = cacheSymbols(builder, canonicalSymbols);
 
   /* Create Flatbuffers */
   auto ppcache = PARSECACHE::CreateParseCache(
-      builder, header, errorSymbolPair.first, errorSymbolPair.second,
-      elementList, objectList);
+      builder, header, errorList, symbolList, elementList, objectList);
   FinishParseCacheBuffer(builder, ppcache);
 
   /* Save Flatbuffer */
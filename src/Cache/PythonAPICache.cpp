@@ -163,14 +163,14 @@ bool PythonAPICache::save() {
       m_listener->getCompileSourceFile()->getErrorContainer();
   SymbolId subjectFileId = m_listener->getParseFile()->getFileId(LINE1);
   SymbolTable canonicalSymbols;
-  auto errorSymbolPair = cacheErrors(
+  auto errorList = cacheErrors(
       builder, canonicalSymbols, errorContainer,
       m_listener->getCompileSourceFile()->getSymbolTable(), subjectFileId);
+  auto symbolList = cacheSymbols(builder, canonicalSymbols);
 
   /* Create Flatbuffers */
   auto ppcache = PYTHONAPICACHE::CreatePythonAPICache(
-      builder, header, scriptFile, errorSymbolPair.first,
-      errorSymbolPair.second);
+      builder, header, scriptFile, errorList, symbolList);
   FinishPythonAPICacheBuffer(builder, ppcache);
 
   /* Save Flatbuffer */
@@ -162,7 +162,10 @@ static const std::initializer_list<std::string_view> helpText = {
     "coveruhdm, vpi_ids",
     "  -nostdout             Mutes Standard output",
     "  -verbose              Gives verbose processing information",
-    "  -profile              Gives Profiling information",
+    "  -profile              Gives Profiling information, writes the grammar "
+    "decisions",
+    "                        profile in parser_profile.json/.csv under output "
+    "dir",
     "  -replay               Enables replay of internal elaboration errors",
     "  -l <file>             Specifies log file, default is surelog.log under "
     "output dir",
@@ -183,6 +186,15 @@ static const std::initializer_list<std::string_view> helpText = {
     "  -nohash               Don't use hash mechanism for cache file path, "
     "always treat cache as valid (no timestamp/dependancy check)"
     "  -createcache          Create cache for precompiled packages",
+    "  -dfacache             Warms up the parsers with the prediction DFA "
+    "snapshot found in the cache directory",
+    "  -createdfacache       Saves the parsers prediction DFA in the cache "
+    "directory at the end of the run (combine with -dfacache to accumulate)",
+    "  -fastlexer            Uses the hand-written lexer instead of the "
+    "generated one",
+    "  -streamparse          Builds the AST while parsing, releasing the parse "
+    "tree of each top-level description once walked (ignored with "
+    "-pythonlistener)",
     "  -filterdirectives     Filters out simple directives like",
     "                        `default_nettype in pre-processor's output",
     "  -filterprotected      Filters out protected regions in pre-processor's "
@@ -330,6 +342,10 @@ CommandLineParser::CommandLineParser(ErrorContainer* errors,
       m_pythonListenerFileId(0),
       m_debugIncludeFileInfo(false),
       m_createCache(false),
+      m_dfaCache(false),
+      m_createDfaCache(false),
+      m_fastLexer(false),
+      m_streamParse(false),
       m_profile(false),
       m_parseBuiltIn(true),
       m_ppOutputFileLocation(false),
@@ -833,6 +849,14 @@ bool CommandLineParser::parseCommandLine(int argc, const char** argv) {
       m_topLevelModules.insert(all_arguments[i]);
     } else if (all_arguments[i] == "-createcache") {
       m_createCache = true;
+    } else if (all_arguments[i] == "-dfacache") {
+      m_dfaCache = true;
+    } else if (all_arguments[i] == "-createdfacache") {
+      m_createDfaCache = true;
+    } else if (all_arguments[i] == "-fastlexer") {
+      m_fastLexer = true;
+    } else if (all_arguments[i] == "-streamparse") {
+      m_streamParse = true;
     } else if (all_arguments[i] == "-lineoffsetascomments") {
       m_lineOffsetsAsComments = true;
     } else if (all_arguments[i] == "-v") {
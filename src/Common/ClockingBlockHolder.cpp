@@ -26,15 +26,13 @@
 namespace SURELOG {
 void ClockingBlockHolder::addClockingBlock(SymbolId blockId,
                                            ClockingBlock& block) {
-  m_clockingBlockMap.insert(std::make_pair(blockId, block));
+  m_clockingBlockMap.emplace_back(blockId, block);
 }
 
 ClockingBlock* ClockingBlockHolder::getClockingBlock(SymbolId blockId) {
-  ClockingBlockMap::iterator itr = m_clockingBlockMap.find(blockId);
-  if (itr != m_clockingBlockMap.end()) {
-    return &(*itr).second;
-  } else {
-    return nullptr;
+  for (auto& itr : m_clockingBlockMap) {
+    if (itr.first == blockId) return &itr.second;
   }
+  return nullptr;
 }
 }  // namespace SURELOG
@@ -242,52 +242,34 @@ ModuleInstance* Design::findInstance(const std::string& path,
 ModuleInstance* Design::findInstance(const std::vector<std::string>& path,
                                      ModuleInstance* scope) const {
   if (path.empty()) return nullptr;
-  if (scope) {
-    ModuleInstance* res = findInstance_(path, scope);
+  if (scope) return findInstance_(path, 0, scope);
+  auto itr = m_topLevelModuleInstancesByName.find(path[0]);
+  if (itr == m_topLevelModuleInstancesByName.end()) return nullptr;
+  for (ModuleInstance* top : itr->second) {
+    if (path.size() == 1) return top;
+    ModuleInstance* res = findInstance_(path, 1, top);
     if (res) return res;
-  } else {
-    for (auto top : m_topLevelModuleInstances) {
-      if (path.size() == 1) {
-        if (top->getInstanceName() == path[0]) {
-          return top;
-        }
-      } else {
-        if (top->getInstanceName() == path[0]) {
-          std::vector<std::string> subpath = path;
-          subpath.erase(subpath.begin());
-          ModuleInstance* res = findInstance_(subpath, top);
-          if (res) return res;
-        }
-      }
-    }
   }
-
   return nullptr;
 }
 
 ModuleInstance* Design::findInstance_(const std::vector<std::string>& path,
+                                      unsigned int index,
                                       ModuleInstance* scope) const {
-  if (path.empty()) return nullptr;
+  if (index >= path.size()) return nullptr;
   if (scope == nullptr) return nullptr;
-  if (path.size() == 1) {
-    if (scope->getInstanceName() == path[0]) {
-      return scope;
-    }
+  const bool last = (index + 1 == path.size());
+  if (last && (scope->getInstanceName() == path[index])) {
+    return scope;
   }
 
-  for (unsigned int i = 0; i < scope->getNbChildren(); i++) {
-    ModuleInstance* child = scope->getChildren(i);
-    if (path.empty()) continue;
-    if (child->getInstanceName() == path[0]) {
-      if (path.size() == 1) {
-        return child;
-      } else {
-        std::vector<std::string> subpath = path;
-        subpath.erase(subpath.begin());
-        ModuleInstance* res = findInstance(subpath, child);
-        if (res) return res;
-      }
-    }
+  const std::vector<ModuleInstance*>* children =
+      scope->getChildrenByName(path[index]);
+  if (children == nullptr) return nullptr;
+  for (ModuleInstance* child : *children) {
+    if (last) return child;
+    ModuleInstance* res = findInstance_(path, index + 1, child);
+    if (res) return res;
   }
   return nullptr;
 }
@@ -304,6 +286,26 @@ DefParam* Design::getDefParam(const std::string& name) const {
   return nullptr;
 }
 
+DefParam* Design::getDefParam(ModuleInstance* instance,
+                               std::string_view name) const {
+  if (m_defParams.empty()) return nullptr;
+  // A name that was never interned cannot be in the trie
+  const SymbolId id = m_errors->getSymbolTable()->getId(name);
+  if (id == SymbolTable::getBadId()) return nullptr;
+  DefParam* scope = getDefParamScope_(instance);
+  return scope ? scope->getChild(id) : nullptr;
+}
+
+DefParam* Design::getDefParamScope_(ModuleInstance* instance) const {
+  const SymbolId id = instance->getInstanceId(m_errors->getSymbolTable());
+  if (ModuleInstance* parent = instance->getParent()) {
+    DefParam* scope = getDefParamScope_(parent);
+    return scope ? scope->getChild(id) : nullptr;
+  }
+  auto itr = m_defParamIds.find(id);
+  return (itr == m_defParamIds.end()) ? nullptr : itr->second;
+}
+
 Value* Design::getDefParamValue(const std::string& name) {
   DefParam* def = getDefParam(name);
   if (def) return def->getValue();
@@ -335,6 +337,8 @@ void Design::addDefParam(const std::string& name, const FileContent* fC,
   } else {
     DefParam* def = new DefParam(vpath[0]);
     m_defParams.insert(std::make_pair(vpath[0], def));
+    m_defParamIds.insert(std::make_pair(
+        m_errors->getSymbolTable()->registerSymbol(vpath[0]), def));
     vpath.erase(vpath.begin());
     addDefParam_(vpath, fC, nodeId, value, def);
   }
@@ -370,7 +374,8 @@ void Design::addDefParam_(std::vector<std::string>& path, const FileContent* fC,
     addDefParam_(path, fC, nodeId, value, (*itr).second);
   } else {
     DefParam* def = new DefParam(path[0], parent);
-    parent->setChild(path[0], def);
+    parent->setChild(path[0],
+                     m_errors->getSymbolTable()->registerSymbol(path[0]), def);
     path.erase(path.begin());
     addDefParam_(path, fC, nodeId, value, def);
   }
@@ -493,6 +498,12 @@ Package* Design::addPackageDefinition(const std::string& packageName,
   }
 }
 
+void Design::addTopLevelModuleInstance(ModuleInstance* instance) {
+  m_topLevelModuleInstances.push_back(instance);
+  m_topLevelModuleInstancesByName[instance->getInstanceName()].push_back(
+      instance);
+}
+
 void Design::addClassDefinition(const std::string& className,
                                 ClassDefinition* classDef) {
   m_classDefinitions.insert(std::make_pair(className, classDef));
@@ -503,8 +514,10 @@ void Design::clearContainers() {
   m_moduleDefinitions.clear();
 
   m_topLevelModuleInstances.clear();
+  m_topLevelModuleInstancesByName.clear();
 
   m_defParams.clear();
+  m_defParamIds.clear();
 
   m_packageDefinitions.clear();
 
@@ -37,6 +37,5 @@ DesignElement::DesignElement(SymbolId name, SymbolId fileId, ElemType type,
       m_endLine(endLine),
       m_endColumn(endColumn),
       m_parent(parent),
-      m_node(0),
-      m_context(nullptr) {}
+      m_node(0) {}
 }  // namespace SURELOG
@@ -27,10 +27,13 @@
 #include <Surelog/SourceCompile/SymbolTable.h>
 
 #include <iostream>
+#include <memory>
 #include <stack>
 
 namespace SURELOG {
 
+FileContent::~FileContent() = default;
+
 const std::string& FileContent::getName() const {
   return m_symbolTable->getSymbol(m_fileId);
 }
@@ -348,6 +351,30 @@ unsigned short FileContent::EndColumn(NodeId index) const {
   return m_objects[index].m_endColumn;
 }
 
+const VObjectTypeIndex* FileContent::typeIndex_() const {
+  const VObjectTypeIndex* index = m_typeIndex.load(std::memory_order_acquire);
+  // The tree is only built or extended single threaded (parsing, cache
+  // loading), a size change invalidates the index
+  if (index && (index->nodeCount() == m_objects.size())) return index;
+  std::lock_guard<std::mutex> lock(m_typeIndexMutex);
+  if (!m_typeIndexStorage ||
+      (m_typeIndexStorage->nodeCount() != m_objects.size())) {
+    m_typeIndexStorage = std::make_unique<VObjectTypeIndex>(m_objects);
+    m_typeIndex.store(m_typeIndexStorage.get(), std::memory_order_release);
+  }
+  return m_typeIndexStorage.get();
+}
+
+void FileContent::SetType(NodeId index, VObjectType type) {
+  if (index >= m_objects.size()) return;
+  std::lock_guard<std::mutex> lock(m_typeIndexMutex);
+  if (m_typeIndexStorage &&
+      (m_typeIndexStorage->nodeCount() == m_objects.size())) {
+    m_typeIndexStorage->retype(index, m_objects[index].m_type, type);
+  }
+  m_objects[index].m_type = type;
+}
+
 NodeId FileContent::sl_get(NodeId parent, VObjectType type) {
   if (m_objects.empty()) return 0;
   if (parent > m_objects.size() - 1) return 0;
@@ -451,15 +478,20 @@ std::vector<NodeId> FileContent::sl_get_all(NodeId parent,
 NodeId FileContent::sl_collect(NodeId parent, VObjectType type) const {
   if (m_objects.empty()) return 0;
   if (parent > m_objects.size() - 1) return 0;
-  VObject current = Object(parent);
-  if (current.m_type == type) return parent;
-  NodeId id = current.m_child;
+  const VObjectTypeIndex* const index = typeIndex_();
+  if (index->contains(parent)) {
+    const std::vector<NodeId> found =
+        index->collect(parent, true, {type}, {}, true);
+    return found.empty() ? InvalidNodeId : found.front();
+  }
+  if (m_objects[parent].m_type == type) return parent;
+  NodeId id = m_objects[parent].m_child;
   while (id) {
     NodeId idsub = sl_collect(id, type);
     if (idsub != InvalidNodeId) {
       return idsub;
     }
-    current = Object(id);
+    const VObject& current = m_objects[id];
     if (current.m_type == type) {
       return id;
     }
@@ -473,16 +505,22 @@ std::vector<NodeId> FileContent::sl_collect_all(NodeId parent, VObjectType type,
   std::vector<NodeId> objects;
   if (m_objects.empty()) return objects;
   if (parent > m_objects.size() - 1) return objects;
-  VObject current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  // Without children, the walk below visits the following siblings
+  if (m_objects[parent].m_child) {
+    const VObjectTypeIndex* const index = typeIndex_();
+    if (index->contains(parent)) {
+      return index->collect(parent, false, {type}, {}, first);
+    }
+  }
+  NodeId id = m_objects[parent].m_child;
+  if (!id) id = m_objects[parent].m_sibling;
   if (!id) return objects;
   std::stack<NodeId> stack;
   stack.push(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    current = Object(id);
+    const VObject& current = m_objects[id];
     if (current.m_type == type) {
       objects.push_back(id);
       if (first) return objects;
@@ -499,16 +537,21 @@ std::vector<NodeId> FileContent::sl_collect_all(NodeId parent,
   std::vector<NodeId> objects;
   if (m_objects.empty()) return objects;
   if (parent > m_objects.size() - 1) return objects;
-  VObject current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  if (m_objects[parent].m_child) {
+    const VObjectTypeIndex* const index = typeIndex_();
+    if (index->contains(parent)) {
+      return index->collect(parent, false, types, {}, first);
+    }
+  }
+  NodeId id = m_objects[parent].m_child;
+  if (!id) id = m_objects[parent].m_sibling;
   if (!id) return objects;
   std::stack<NodeId> stack;
   stack.push(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    current = Object(id);
+    const VObject& current = m_objects[id];
     // std::cout << "COLLECT:" << current.print (m_symbolTable, id,
     // GetDefinitionFile(id)) << std::endl;
     for (auto type : types) {
@@ -529,16 +572,23 @@ NodeId FileContent::sl_collect(NodeId parent, VObjectType type,
   NodeId result = InvalidNodeId;
   if (m_objects.empty()) return result;
   if (parent > m_objects.size() - 1) return result;
-  VObject current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  if (m_objects[parent].m_child) {
+    const VObjectTypeIndex* const index = typeIndex_();
+    if (index->contains(parent)) {
+      const std::vector<NodeId> found =
+          index->collect(parent, false, {type}, {stopPoint}, true);
+      return found.empty() ? InvalidNodeId : found.front();
+    }
+  }
+  NodeId id = m_objects[parent].m_child;
+  if (!id) id = m_objects[parent].m_sibling;
   if (!id) return result;
   std::stack<NodeId> stack;
   stack.push(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    current = Object(id);
+    const VObject& current = m_objects[id];
     if (current.m_type == type) {
       return id;
     }
@@ -559,16 +609,21 @@ std::vector<NodeId> FileContent::sl_collect_all(
   std::vector<NodeId> objects;
   if (m_objects.empty()) return objects;
   if (parent > m_objects.size() - 1) return objects;
-  VObject current = Object(parent);
-  NodeId id = current.m_child;
-  if (!id) id = current.m_sibling;
+  if (m_objects[parent].m_child) {
+    const VObjectTypeIndex* const index = typeIndex_();
+    if (index->contains(parent)) {
+      return index->collect(parent, false, types, stopPoints, first);
+    }
+  }
+  NodeId id = m_objects[parent].m_child;
+  if (!id) id = m_objects[parent].m_sibling;
   if (!id) return objects;
   std::stack<NodeId> stack;
   stack.push(id);
   while (!stack.empty()) {
     id = stack.top();
     stack.pop();
-    current = Object(id);
+    const VObject& current = m_objects[id];
     // std::cout << "COLLECT:" << current.print (m_symbolTable, id,
     // GetDefinitionFile(id)) << std::endl;
     for (auto type : types) {
@@ -152,10 +152,27 @@ Value* ModuleInstance::getValue(const std::string& name,
 }
 
 ModuleInstance* ModuleInstance::getChildByName(const std::string& name) {
-  for (auto child : m_allSubInstances) {
-    if (child->getInstanceName() == name) return child;
+  const std::vector<ModuleInstance*>* children = getChildrenByName(name);
+  return children ? children->front() : nullptr;
+}
+
+const std::vector<ModuleInstance*>* ModuleInstance::getChildrenByName(
+    const std::string& name) {
+  // The elaboration appends the children, through addSubInstance or
+  // getAllSubInstances(), the ones added since the last lookup are indexed
+  // now. overrideParentChild resets the index.
+  if (m_nbIndexedChildren > m_allSubInstances.size()) {
+    m_childrenByName.clear();
+    m_nbIndexedChildren = 0;
   }
-  return nullptr;
+  for (; m_nbIndexedChildren < m_allSubInstances.size();
+       m_nbIndexedChildren++) {
+    ModuleInstance* child = m_allSubInstances[m_nbIndexedChildren];
+    m_childrenByName[child->getInstanceName()].push_back(child);
+  }
+  auto itr = m_childrenByName.find(name);
+  if (itr == m_childrenByName.end()) return nullptr;
+  return &itr->second;
 }
 
 std::string ModuleInstance::decompile(char* valueName) {
@@ -231,7 +248,11 @@ SymbolId ModuleInstance::getFullPathId(SymbolTable* symbols) {
 }
 
 SymbolId ModuleInstance::getInstanceId(SymbolTable* symbols) {
-  return symbols->registerSymbol(getInstanceName());
+  if (m_instanceIdSymbols != symbols) {
+    m_instanceId = symbols->registerSymbol(getInstanceName());
+    m_instanceIdSymbols = symbols;
+  }
+  return m_instanceId;
 }
 SymbolId ModuleInstance::getModuleNameId(SymbolTable* symbols) {
   return symbols->registerSymbol(getModuleName());
@@ -301,6 +322,8 @@ void ModuleInstance::overrideParentChild(ModuleInstance* parent,
   }
 
   m_allSubInstances = children;
+  m_childrenByName.clear();
+  m_nbIndexedChildren = 0;
 }
 
 void ModuleInstance::setOverridenParam(const std::string& name) {
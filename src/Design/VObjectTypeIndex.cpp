@@ -0,0 +1,130 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/Design/VObject.h>
+#include <Surelog/Design/VObjectTypeIndex.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace SURELOG {
+
+VObjectTypeIndex::VObjectTypeIndex(const std::vector<VObject>& objects)
+    : m_ranks(objects.size(), kNotRanked),
+      m_subtreeEnd(objects.size(), 0) {
+  const size_t size = objects.size();
+  if (size == 0) return;
+  m_nodes.reserve(size);
+
+  // Same traversal as the sl_collect walkers: children before siblings.
+  // owners[rank] is the node whose child list holds the node of that rank.
+  std::vector<unsigned int> owners;
+  owners.reserve(size);
+  std::vector<std::pair<NodeId, unsigned int>> stack;
+  stack.emplace_back(0, kNotRanked);
+  while (!stack.empty()) {
+    const auto [node, owner] = stack.back();
+    stack.pop_back();
+    if ((node >= size) || (m_ranks[node] != kNotRanked)) continue;
+    const unsigned int rank = m_nodes.size();
+    m_ranks[node] = rank;
+    m_nodes.push_back(node);
+    owners.push_back(owner);
+    const VObject& object = objects[node];
+    if (object.m_sibling) stack.emplace_back(object.m_sibling, owner);
+    if (object.m_child) stack.emplace_back(object.m_child, rank);
+  }
+
+  // Subtree sizes, accumulated bottom-up in reverse pre-order
+  std::vector<unsigned int> sizes(m_nodes.size(), 1);
+  for (unsigned int rank = m_nodes.size(); rank-- > 0;) {
+    if (owners[rank] != kNotRanked) sizes[owners[rank]] += sizes[rank];
+  }
+  for (unsigned int rank = 0; rank < m_nodes.size(); ++rank) {
+    const NodeId node = m_nodes[rank];
+    m_subtreeEnd[node] = rank + sizes[rank];
+    const unsigned short type = objects[node].m_type;
+    if (type >= m_typeRanks.size()) m_typeRanks.resize(type + 1);
+    m_typeRanks[type].push_back(rank);
+  }
+}
+
+void VObjectTypeIndex::ranksInRange_(const std::vector<VObjectType>& types,
+                                     unsigned int begin, unsigned int end,
+                                     bool first,
+                                     std::vector<unsigned int>& ranks) const {
+  size_t lists = 0;
+  for (size_t i = 0; i < types.size(); ++i) {
+    const unsigned short type = types[i];
+    if (type >= m_typeRanks.size()) continue;
+    if (std::find(types.begin(), types.begin() + i, types[i]) !=
+        types.begin() + i)
+      continue;
+    const std::vector<unsigned int>& typeRanks = m_typeRanks[type];
+    auto from = std::lower_bound(typeRanks.begin(), typeRanks.end(), begin);
+    auto to = std::lower_bound(from, typeRanks.end(), end);
+    if (from == to) continue;
+    if (first) to = from + 1;
+    ranks.insert(ranks.end(), from, to);
+    ++lists;
+  }
+  if (lists > 1) std::sort(ranks.begin(), ranks.end());
+}
+
+std::vector<NodeId> VObjectTypeIndex::collect(
+    NodeId parent, bool includeParent, const std::vector<VObjectType>& types,
+    const std::vector<VObjectType>& stopPoints, bool first) const {
+  std::vector<NodeId> result;
+  if (!contains(parent)) return result;
+  const unsigned int begin = m_ranks[parent] + (includeParent ? 0 : 1);
+  const unsigned int end = m_subtreeEnd[parent];
+
+  std::vector<unsigned int> ranks;
+  std::vector<unsigned int> stops;
+  if (!stopPoints.empty()) ranksInRange_(stopPoints, begin, end, false, stops);
+  // The first match may be under a stop point, keep them all in that case
+  ranksInRange_(types, begin, end, first && stops.empty(), ranks);
+
+  // Sweep the stop points in rank order, the subtree of a stop point is
+  // excluded but not the stop point itself
+  unsigned int excludedEnd = 0;
+  auto stop = stops.begin();
+  for (const unsigned int rank : ranks) {
+    for (; (stop != stops.end()) && (*stop < rank); ++stop) {
+      excludedEnd = std::max(excludedEnd, m_subtreeEnd[m_nodes[*stop]]);
+    }
+    if (rank < excludedEnd) continue;
+    result.push_back(m_nodes[rank]);
+    if (first) break;
+  }
+  return result;
+}
+
+void VObjectTypeIndex::retype(NodeId node, unsigned short from,
+                              unsigned short to) {
+  if (!contains(node) || (from == to)) return;
+  const unsigned int rank = m_ranks[node];
+  if (from < m_typeRanks.size()) {
+    std::vector<unsigned int>& ranks = m_typeRanks[from];
+    auto found = std::lower_bound(ranks.begin(), ranks.end(), rank);
+    if ((found != ranks.end()) && (*found == rank)) ranks.erase(found);
+  }
+  if (to >= m_typeRanks.size()) m_typeRanks.resize(to + 1);
+  std::vector<unsigned int>& ranks = m_typeRanks[to];
+  ranks.insert(std::lower_bound(ranks.begin(), ranks.end(), rank), rank);
+}
+
+}  // namespace SURELOG
@@ -0,0 +1,129 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/Design/VObject.h>
+#include <Surelog/Design/VObjectTypeIndex.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stack>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+// The walk of FileContent::sl_collect_all from a parent with children
+std::vector<NodeId> walk(const std::vector<VObject>& objects, NodeId parent,
+                         const std::vector<VObjectType>& types,
+                         const std::vector<VObjectType>& stopPoints,
+                         bool first) {
+  std::vector<NodeId> result;
+  std::stack<NodeId> stack;
+  stack.push(objects[parent].m_child);
+  while (!stack.empty()) {
+    const NodeId id = stack.top();
+    stack.pop();
+    for (VObjectType type : types) {
+      if (objects[id].m_type == type) {
+        result.push_back(id);
+        if (first) return result;
+        break;
+      }
+    }
+    if (objects[id].m_sibling) stack.push(objects[id].m_sibling);
+    bool stop = false;
+    for (VObjectType type : stopPoints) stop |= (objects[id].m_type == type);
+    if (objects[id].m_child && !stop) stack.push(objects[id].m_child);
+  }
+  return result;
+}
+
+// Random tree, node 0 is the root with a chain of top level siblings
+std::vector<VObject> randomTree(unsigned int size, unsigned int types,
+                                std::mt19937& rng) {
+  std::vector<VObject> objects;
+  for (unsigned int i = 0; i < size; ++i) {
+    objects.emplace_back(0, 0, (VObjectType)(rng() % types), i, 0, i, 0);
+  }
+  std::vector<NodeId> lastChild(size, 0);
+  for (NodeId node = 1; node < size; ++node) {
+    // Attach under a random earlier node, or to the top level chain
+    const NodeId parent = rng() % node;
+    if ((rng() % 8) == 0) {
+      NodeId last = 0;
+      while (objects[last].m_sibling) last = objects[last].m_sibling;
+      objects[last].m_sibling = node;
+      continue;
+    }
+    objects[node].m_parent = parent;
+    if (lastChild[parent])
+      objects[lastChild[parent]].m_sibling = node;
+    else
+      objects[parent].m_child = node;
+    lastChild[parent] = node;
+  }
+  return objects;
+}
+
+TEST(VObjectTypeIndexTest, MatchesTreeWalk) {
+  std::mt19937 rng(42);
+  for (unsigned int round = 0; round < 20; ++round) {
+    std::vector<VObject> objects = randomTree(500, 6, rng);
+    VObjectTypeIndex index(objects);
+    ASSERT_EQ(index.nodeCount(), objects.size());
+    for (NodeId parent = 0; parent < objects.size(); ++parent) {
+      ASSERT_TRUE(index.contains(parent));
+      if (!objects[parent].m_child) continue;
+      const std::vector<VObjectType> types = {(VObjectType)(rng() % 6),
+                                              (VObjectType)(rng() % 6)};
+      const std::vector<VObjectType> stops = {(VObjectType)(rng() % 6)};
+      for (bool first : {false, true}) {
+        EXPECT_EQ(index.collect(parent, false, types, {}, first),
+                  walk(objects, parent, types, {}, first));
+        EXPECT_EQ(index.collect(parent, false, types, stops, first),
+                  walk(objects, parent, types, stops, first));
+      }
+    }
+  }
+}
+
+TEST(VObjectTypeIndexTest, RetypeAndIncludeParent) {
+  // 0 -> 1 { 2 { 3 } 4 }
+  std::vector<VObject> objects;
+  objects.emplace_back(0, 0, (VObjectType)0, 0, 0, 0, 0, 0, 0, 0, 1);
+  objects.emplace_back(0, 0, (VObjectType)1, 0, 0, 0, 0, 0, 0, 2, 0);
+  objects.emplace_back(0, 0, (VObjectType)2, 0, 0, 0, 0, 1, 0, 3, 4);
+  objects.emplace_back(0, 0, (VObjectType)1, 0, 0, 0, 0, 2, 0, 0, 0);
+  objects.emplace_back(0, 0, (VObjectType)2, 0, 0, 0, 0, 1, 0, 0, 0);
+  VObjectTypeIndex index(objects);
+  const VObjectType one = (VObjectType)1;
+  const VObjectType two = (VObjectType)2;
+
+  EXPECT_EQ(index.collect(1, true, {one}, {}, false),
+            std::vector<NodeId>({1, 3}));
+  EXPECT_EQ(index.collect(1, false, {one}, {}, false),
+            std::vector<NodeId>({3}));
+  EXPECT_EQ(index.collect(1, false, {one, two}, {two}, false),
+            std::vector<NodeId>({2, 4}));
+
+  index.retype(4, 2, 1);
+  EXPECT_EQ(index.collect(1, false, {one}, {}, false),
+            std::vector<NodeId>({3, 4}));
+  EXPECT_EQ(index.collect(1, false, {two}, {}, false),
+            std::vector<NodeId>({2}));
+}
+}  // namespace
+}  // namespace SURELOG
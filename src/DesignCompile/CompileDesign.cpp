@@ -114,7 +114,7 @@ void CompileDesign::compileMT_(ObjectMapType& objects, int maxThreadCount) {
   if (maxThreadCount == 0) {
     for (const auto& itr : objects) {
       FunctorType funct(this, itr.second, m_compiler->getDesign(),
-                        m_symbolTables[0], m_errorContainers[0]);
+                        m_compiler->getSymbolTable(), m_errorContainers[0]);
       funct.operator()();
     }
   } else {
@@ -156,7 +156,8 @@ void CompileDesign::compileMT_(ObjectMapType& objects, int maxThreadCount) {
       std::thread* th = new std::thread([=] {
         for (unsigned int j = 0; j < jobArray[i].size(); j++) {
           FunctorType funct(this, jobArray[i][j], m_compiler->getDesign(),
-                            m_symbolTables[i], m_errorContainers[i]);
+                            m_compiler->getSymbolTable(),
+                            m_errorContainers[i]);
           funct.operator()();
         }
       });
@@ -288,10 +289,7 @@ bool CompileDesign::compilation_() {
 
   int index = 0;
   do {
-    SymbolTable* symbols =
-        new SymbolTable(m_compiler->getCommandLineParser()->getSymbolTable());
-    m_symbolTables.push_back(symbols);
-    ErrorContainer* errors = new ErrorContainer(symbols);
+    ErrorContainer* errors = new ErrorContainer(m_compiler->getSymbolTable());
     errors->registerCmdLine(m_compiler->getCommandLineParser());
     m_errorContainers.push_back(errors);
     index++;
@@ -317,7 +315,8 @@ bool CompileDesign::compilation_() {
   // Compile packages in strict order
   for (auto itr : m_compiler->getDesign()->getOrderedPackageDefinitions()) {
     FunctorCompilePackage funct(this, itr, m_compiler->getDesign(),
-                                m_symbolTables[0], m_errorContainers[0]);
+                                m_compiler->getSymbolTable(),
+                                m_errorContainers[0]);
     funct.operator()();
   }
 
@@ -349,10 +348,9 @@ bool CompileDesign::compilation_() {
 
   m_compiler->getDesign()->orderPackages();
 
-  unsigned int size = m_symbolTables.size();
+  unsigned int size = m_errorContainers.size();
   for (unsigned int i = 0; i < size; i++) {
     m_compiler->getErrorContainer()->appendErrors(*m_errorContainers[i]);
-    delete m_symbolTables[i];
     delete m_errorContainers[i];
   }
   return true;
@@ -832,8 +832,7 @@ void DesignElaboration::elaborateInstance_(
   // Apply DefParams
   Design* design = m_compileDesign->getCompiler()->getDesign();
   for (const auto& name : params) {
-    DefParam* defparam =
-        design->getDefParam(parent->getFullPathName() + "." + name);
+    DefParam* defparam = design->getDefParam(parent, name);
     if (defparam) {
       Value* value = defparam->getValue();
       if (value) {
@@ -1997,8 +1996,8 @@ void DesignElaboration::collectParams_(std::vector<std::string>& params,
 
     // path refers to a sub instance
     std::string prefix;
-    if (design->findInstance(pathRoot)) {
-      std::string p = design->findInstance(pathRoot)->getFullPathName();
+    if (ModuleInstance* root = design->findInstance(pathRoot)) {
+      std::string p = root->getFullPathName();
       if (p.find('.') != std::string::npos) {
         prefix = instance->getFullPathName() + ".";
       } else {
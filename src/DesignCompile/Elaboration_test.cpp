@@ -14,6 +14,7 @@
  limitations under the License.
 */
 
+#include <Surelog/Design/DefParam.h>
 #include <Surelog/Design/Design.h>
 #include <Surelog/Design/FileContent.h>
 #include <Surelog/Design/ModuleInstance.h>
@@ -21,6 +22,7 @@
 #include <Surelog/DesignCompile/CompileHelper.h>
 #include <Surelog/DesignCompile/ElaboratorHarness.h>
 #include <Surelog/SourceCompile/Compiler.h>
+#include <Surelog/SourceCompile/SymbolTable.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -402,5 +404,91 @@ endmodule
   }
 }
 
+// The instance and its descendants
+void collectInstances(ModuleInstance* instance,
+                      std::vector<ModuleInstance*>& instances) {
+  instances.push_back(instance);
+  for (unsigned int i = 0; i < instance->getNbChildren(); i++) {
+    collectInstances(instance->getChildren(i), instances);
+  }
+}
+
+ModuleInstance* findChild(ModuleInstance* instance, std::string_view name) {
+  for (unsigned int i = 0; i < instance->getNbChildren(); i++) {
+    ModuleInstance* child = instance->getChildren(i);
+    if (child->getInstanceName() == name) return child;
+  }
+  return nullptr;
+}
+
+TEST(Elaboration, DefParamByInstance) {
+  CompileHelper helper;
+  ElaboratorHarness eharness;
+  Design* design;
+  FileContent* fC;
+  CompileDesign* compileDesign;
+  // Preprocess, Parse, Compile, Elaborate
+  std::tie(design, fC, compileDesign) = eharness.elaborate(R"(
+  module leaf();
+    parameter WIDTH = 1;
+    parameter DEPTH = 2;
+  endmodule
+  module mid();
+    parameter DEPTH = 3;
+    leaf u2();
+  endmodule
+  module top();
+    parameter WIDTH = 4;
+    mid u1();
+    leaf u3();
+    defparam u1.u2.WIDTH = 8;
+    defparam u1.DEPTH = 5;
+    defparam u3.DEPTH = 6;
+  endmodule)");
+  ASSERT_EQ(design->getTopLevelModuleInstances().size(), 1);
+  ModuleInstance* top = design->getTopLevelModuleInstances()[0];
+  ModuleInstance* u1 = findChild(top, "u1");
+  ASSERT_NE(u1, nullptr);
+  ModuleInstance* u2 = findChild(u1, "u2");
+  ASSERT_NE(u2, nullptr);
+
+  // Same trie node as the lookup of the full path, including the inner
+  // nodes ("u1") and the misses
+  std::vector<ModuleInstance*> instances;
+  collectInstances(top, instances);
+  EXPECT_EQ(instances.size(), 4);
+  for (ModuleInstance* instance : instances) {
+    for (const std::string name :
+         {"WIDTH", "DEPTH", "u1", "u2", "NOT_A_PARAM"}) {
+      DefParam* byPath =
+          design->getDefParam(instance->getFullPathName() + "." + name);
+      EXPECT_EQ(design->getDefParam(instance, name), byPath)
+          << instance->getFullPathName() << "." << name;
+    }
+  }
+  ASSERT_NE(design->getDefParam(u2, "WIDTH"), nullptr);
+  EXPECT_EQ(design->getDefParam(u2, "WIDTH")->getFullName(),
+            u2->getFullPathName() + ".WIDTH");
+  EXPECT_EQ(design->getDefParam(u2, "DEPTH"), nullptr);
+
+  EXPECT_EQ(design->findInstance(top->getFullPathName() + ".u1.u2"), u2);
+  EXPECT_EQ(design->findInstance("u1.u2", top), u2);
+  EXPECT_EQ(design->findInstance(top->getFullPathName() + ".u2"), nullptr);
+  // The names of a path are not added to the symbol table
+  SymbolTable* symbols = compileDesign->getCompiler()->getSymbolTable();
+  EXPECT_EQ(design->findInstance(top->getFullPathName() + ".u1.no_inst"),
+            nullptr);
+  EXPECT_EQ(symbols->getId("no_inst"), SymbolTable::getBadId());
+
+  // A child added after a lookup is indexed too
+  ModuleInstanceFactory factory;
+  ModuleInstance* late = factory.newModuleInstance(
+      nullptr, u1->getFileContent(), u1->getNodeId(), u1, "u9", "late");
+  u1->addSubInstance(late);
+  EXPECT_EQ(design->findInstance("u1.u9", top), late);
+  EXPECT_EQ(u1->getChildByName("u9"), late);
+  EXPECT_EQ(design->findInstance("u1.u2", top), u2);
+}
+
 }  // namespace
 }  // namespace SURELOG
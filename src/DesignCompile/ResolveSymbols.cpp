@@ -252,7 +252,7 @@ unsigned short ResolveSymbols::Type(NodeId index) const {
 
 bool ResolveSymbols::SetType(NodeId index, unsigned short type) {
   if (index == InvalidNodeId) return false;
-  MutableObject(index)->m_type = type;
+  m_fileData->SetType(index, (VObjectType)type);
   return true;
 }
 
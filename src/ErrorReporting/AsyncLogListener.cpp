@@ -0,0 +1,182 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/ErrorReporting/AsyncLogListener.h>
+
+#include <chrono>
+#include <fstream>
+
+namespace SURELOG {
+
+// Bytes above which the writer stops collecting messages for a batch
+static constexpr size_t kMaxBatchSize = 1 << 20;
+
+static uint64_t roundUpPowerOf2(unsigned int value) {
+  uint64_t result = 2;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+AsyncLogListener::AsyncLogListener(unsigned int ringCapacity)
+    : m_capacity(roundUpPowerOf2(ringCapacity)),
+      m_ring(new Slot[m_capacity]) {
+  for (uint64_t i = 0; i < m_capacity; ++i) {
+    m_ring[i].m_sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+AsyncLogListener::~AsyncLogListener() { stop_(); }
+
+LogListener::LogResult AsyncLogListener::initialize(
+    const std::string &filename) {
+  // Drains the messages of a previous log file
+  stop_();
+  const LogResult result = LogListener::initialize(filename);
+  if (failed(result)) return result;
+  m_stop.store(false, std::memory_order_relaxed);
+  m_failed.store(false, std::memory_order_relaxed);
+  m_writer = std::thread(&AsyncLogListener::run_, this);
+  m_started.store(true, std::memory_order_release);
+  return result;
+}
+
+void AsyncLogListener::stop_() {
+  if (!m_writer.joinable()) return;
+  m_started.store(false, std::memory_order_release);
+  m_stop.store(true, std::memory_order_release);
+  {
+    std::scoped_lock<std::mutex> lock(m_wakeMutex);
+    m_wake.notify_one();
+  }
+  m_writer.join();
+}
+
+bool AsyncLogListener::tryPush_(const std::string &message) {
+  uint64_t ticket = m_head.load(std::memory_order_relaxed);
+  while (true) {
+    Slot &slot = m_ring[ticket & (m_capacity - 1)];
+    const uint64_t sequence = slot.m_sequence.load(std::memory_order_acquire);
+    const int64_t diff =
+        static_cast<int64_t>(sequence) - static_cast<int64_t>(ticket);
+    if (diff == 0) {
+      if (m_head.compare_exchange_weak(ticket, ticket + 1,
+                                       std::memory_order_relaxed)) {
+        slot.m_message = message;
+        slot.m_sequence.store(ticket + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;  // Full, the slot still holds the previous round
+    } else {
+      ticket = m_head.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncLogListener::tryPop_(std::string &batch) {
+  Slot &slot = m_ring[m_tail & (m_capacity - 1)];
+  if (slot.m_sequence.load(std::memory_order_acquire) != m_tail + 1) {
+    return false;
+  }
+  batch += slot.m_message;
+  // Releases large reports instead of keeping them in the ring
+  std::string().swap(slot.m_message);
+  slot.m_sequence.store(m_tail + m_capacity, std::memory_order_release);
+  ++m_tail;
+  return true;
+}
+
+LogListener::LogResult AsyncLogListener::log(const std::string &message) {
+  if (!m_started.load(std::memory_order_acquire)) {
+    return LogListener::log(message);
+  }
+  // Back-pressure: wait for the writer rather than dropping messages
+  for (unsigned int attempt = 0; !tryPush_(message); ++attempt) {
+    m_wake.notify_one();
+    if (attempt < 16) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  if (m_writerWaiting.load(std::memory_order_relaxed)) m_wake.notify_one();
+  return m_failed.load(std::memory_order_relaxed)
+             ? LogResult::FailedToOpenFileForWrite
+             : LogResult::Ok;
+}
+
+LogListener::LogResult AsyncLogListener::flush() {
+  if (!m_started.load(std::memory_order_acquire)) {
+    return LogListener::flush();
+  }
+  const uint64_t target = m_head.load(std::memory_order_acquire);
+  m_wake.notify_one();
+  std::unique_lock<std::mutex> lock(m_flushMutex);
+  m_flushed.wait(lock, [this, target] {
+    return m_written.load(std::memory_order_acquire) >= target;
+  });
+  return m_failed.load(std::memory_order_relaxed)
+             ? LogResult::FailedToOpenFileForWrite
+             : LogResult::Ok;
+}
+
+void AsyncLogListener::run_() {
+  std::ofstream strm;
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    strm.open(filename, std::fstream::app);
+    if (!strm.good()) {
+      m_failed.store(true, std::memory_order_relaxed);
+    } else if (!queued.empty()) {
+      // Messages logged before the initialization come first
+      LogListener::flush(strm);
+    }
+  }
+
+  std::string batch;
+  while (true) {
+    batch.clear();
+    while ((batch.size() < kMaxBatchSize) && tryPop_(batch)) {
+    }
+    if (!batch.empty()) {
+      if (strm.good()) {
+        strm.write(batch.data(), batch.size());
+        strm.flush();
+        if (!strm.good()) m_failed.store(true, std::memory_order_relaxed);
+      }
+      m_written.store(m_tail, std::memory_order_release);
+      {
+        std::scoped_lock<std::mutex> lock(m_flushMutex);
+      }
+      m_flushed.notify_all();
+      continue;
+    }
+    if (m_stop.load(std::memory_order_acquire)) {
+      // Tickets taken but not yet filled are still to be written
+      if (m_head.load(std::memory_order_acquire) == m_tail) break;
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_writerWaiting.store(true, std::memory_order_relaxed);
+    // A missed notification only delays the batch by the timeout
+    m_wake.wait_for(lock, std::chrono::milliseconds(2));
+    m_writerWaiting.store(false, std::memory_order_relaxed);
+  }
+  strm.close();
+}
+
+}  // namespace SURELOG
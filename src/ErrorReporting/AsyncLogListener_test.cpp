@@ -0,0 +1,89 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/ErrorReporting/AsyncLogListener.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string readFile(const fs::path& fileName) {
+  std::ifstream ifs(fileName);
+  std::stringstream buffer;
+  buffer << ifs.rdbuf();
+  return buffer.str();
+}
+
+TEST(AsyncLogListenerTest, WritesEveryMessageInOrder) {
+  const fs::path fileName =
+      fs::temp_directory_path() / "surelog_async_log_test.log";
+  constexpr int kThreads = 4;
+  constexpr int kMessages = 2000;
+  {
+    // A tiny ring forces the producers to wait for the writer
+    AsyncLogListener listener(8);
+    EXPECT_EQ(listener.log("before\n"), LogListener::LogResult::Enqueued);
+    ASSERT_EQ(listener.initialize(fileName.string()),
+              LogListener::LogResult::Ok);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&listener, t] {
+        for (int i = 0; i < kMessages; ++i) {
+          listener.log("t" + std::to_string(t) + ":" + std::to_string(i) +
+                       "\n");
+        }
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    EXPECT_EQ(listener.log("flushed\n"), LogListener::LogResult::Ok);
+    EXPECT_EQ(listener.flush(), LogListener::LogResult::Ok);
+    const std::string content = readFile(fileName);
+    EXPECT_EQ(content.rfind("before\n", 0), 0);
+    EXPECT_EQ(content.substr(content.size() - 8), "flushed\n");
+
+    // Each thread's messages, all there and in order
+    std::vector<int> next(kThreads, 0);
+    std::istringstream lines(content);
+    std::string line;
+    while (std::getline(lines, line)) {
+      if ((line == "before") || (line == "flushed")) continue;
+      const int t = line[1] - '0';
+      ASSERT_LT(t, kThreads);
+      EXPECT_EQ(line.substr(3), std::to_string(next[t]));
+      ++next[t];
+    }
+    for (int t = 0; t < kThreads; ++t) EXPECT_EQ(next[t], kMessages);
+
+    listener.log("last\n");
+  }
+  // Drained on destruction
+  const std::string content = readFile(fileName);
+  EXPECT_EQ(content.substr(content.size() - 5), "last\n");
+  fs::remove(fileName);
+}
+}  // namespace
+}  // namespace SURELOG
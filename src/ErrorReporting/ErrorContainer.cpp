@@ -70,47 +70,111 @@ void ErrorContainer::init() {
   }
 }
 
-Error& ErrorContainer::addError(Error& error, bool showDuplicates,
-                                bool reentrantPython) {
-  std::tuple<std::string, bool, bool> textStatus =
-      createErrorMessage(error, reentrantPython);
-  if (std::get<2>(textStatus))  // filter Message
-    return error;
-
-  std::multimap<ErrorDefinition::ErrorType, Waiver::WaiverData>& waivers =
-      Waiver::getWaivers();
-  std::pair<
-      std::multimap<ErrorDefinition::ErrorType, Waiver::WaiverData>::iterator,
-      std::multimap<ErrorDefinition::ErrorType, Waiver::WaiverData>::iterator>
-      ret = waivers.equal_range(error.m_errorId);
-  for (std::multimap<ErrorDefinition::ErrorType, Waiver::WaiverData>::iterator
-           it = ret.first;
-       it != ret.second; ++it) {
-    if ((((*it).second.m_fileName.empty()) ||
-         (m_symbolTable->getSymbol(error.m_locations[0].m_fileId) ==
-          (*it).second.m_fileName)) &&
-        (((*it).second.m_line == 0) ||
-         (error.m_locations[0].m_line == (*it).second.m_line)) &&
-        (((*it).second.m_objectId.empty()) ||
-         (m_symbolTable->getSymbol(error.m_locations[0].m_object) ==
-          (*it).second.m_objectId))) {
-      error.m_waived = true;
-      break;
+uint64_t ErrorContainer::hash_(const Error& error) {
+  uint64_t hash = error.m_errorId;
+  auto combine = [&hash](uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+  };
+  for (const Location& loc : error.m_locations) {
+    combine(loc.m_fileId);
+    combine((static_cast<uint64_t>(loc.m_line) << 16) | loc.m_column);
+    combine(loc.m_object);
+  }
+  return hash;
+}
+
+bool ErrorContainer::isSame_(const Error& lhs, const Error& rhs) {
+  return (lhs.m_errorId == rhs.m_errorId) &&
+         (lhs.m_locations == rhs.m_locations);
+}
+
+bool ErrorContainer::isFiltered_(const Error& error) const {
+  if (error.m_reported || error.m_waived) return false;
+  const std::map<ErrorDefinition::ErrorType, ErrorDefinition::ErrorInfo>&
+      infoMap = ErrorDefinition::getErrorInfoMap();
+  auto itr = infoMap.find(error.m_errorId);
+  if (itr == infoMap.end()) return false;
+  switch (itr->second.m_severity) {
+    case ErrorDefinition::WARNING:
+      return m_clp->filterWarning();
+    case ErrorDefinition::INFO:
+      return m_clp->filterInfo() &&
+             (error.m_errorId != ErrorDefinition::PP_PROCESSING_SOURCE_FILE);
+    case ErrorDefinition::NOTE:
+      return m_clp->filterNote();
+    default:
+      return false;
+  }
+}
+
+void ErrorContainer::indexWaivers_() {
+  const std::multimap<ErrorDefinition::ErrorType, Waiver::WaiverData>&
+      waivers = Waiver::getWaivers();
+  m_waiverIndex.clear();
+  for (const auto& [type, waiver] : waivers) {
+    const SymbolId fileId = waiver.m_fileName.empty()
+                                ? 0
+                                : m_symbolTable->registerSymbol(
+                                      waiver.m_fileName);
+    const SymbolId object = waiver.m_objectId.empty()
+                                ? 0
+                                : m_symbolTable->registerSymbol(
+                                      waiver.m_objectId);
+    m_waiverIndex[std::make_pair(type, fileId)].push_back(
+        {waiver.m_line, object});
+  }
+  m_indexedWaivers = waivers.size();
+}
+
+bool ErrorContainer::isWaived_(const Error& error) {
+  // Waivers are only ever added, a new count means new waivers
+  if (m_indexedWaivers != Waiver::getWaivers().size()) indexWaivers_();
+  if (m_waiverIndex.empty()) return false;
+  const Location& loc = error.m_locations[0];
+  for (const SymbolId fileId : {loc.m_fileId, SymbolId(0)}) {
+    auto itr = m_waiverIndex.find(std::make_pair(error.m_errorId, fileId));
+    if (itr == m_waiverIndex.end()) continue;
+    for (const IndexedWaiver& waiver : itr->second) {
+      if (((waiver.m_line == 0) || (waiver.m_line == loc.m_line)) &&
+          ((waiver.m_object == 0) || (waiver.m_object == loc.m_object))) {
+        return true;
+      }
     }
+    if (fileId == 0) break;
   }
+  return false;
+}
+
+Error& ErrorContainer::addError(Error& error, bool showDuplicates,
+                                bool /* reentrantPython */) {
+  if (isFiltered_(error)) return error;
+
+  if (isWaived_(error)) error.m_waived = true;
 
   if (showDuplicates) {
     m_errors.emplace_back(error);
   } else {
-    if (m_errorSet.find(std::get<0>(textStatus)) == m_errorSet.end()) {
-      m_errors.emplace_back(error);
-      m_errorSet.insert(std::get<0>(textStatus));
+    const uint64_t hash = hash_(error);
+    auto range = m_errorIndex.equal_range(hash);
+    for (auto itr = range.first; itr != range.second; ++itr) {
+      if (isSame_(m_errors[itr->second], error)) {
+        return m_errors[m_errors.size() - 1];
+      }
     }
+    m_errorIndex.emplace(hash, m_errors.size());
+    m_errors.emplace_back(error);
   }
   return m_errors[m_errors.size() - 1];
 }
 
 void ErrorContainer::appendErrors(ErrorContainer& rhs) {
+  if (rhs.m_symbolTable == m_symbolTable) {
+    // Same symbol table, the ids need no translation
+    for (Error err : rhs.m_errors) {
+      if (!err.m_reported) addError(err);
+    }
+    return;
+  }
   for (unsigned int i = 0; i < rhs.m_errors.size(); i++) {
     Error err = rhs.m_errors[i];
     // Translate IDs to master symbol table
@@ -283,10 +347,12 @@ bool ErrorContainer::hasFatalErrors() const {
   return reportFatalError;
 }
 
-std::pair<std::string, bool> ErrorContainer::createReport_() const {
+std::pair<std::string, bool> ErrorContainer::createReport_(
+    size_t from) const {
   std::string report;
   bool reportFatalError = false;
-  for (const Error& msg : m_errors) {
+  for (size_t i = from; i < m_errors.size(); ++i) {
+    const Error& msg = m_errors[i];
     std::tuple<std::string, bool, bool> textStatus = createErrorMessage(msg);
     if (std::get<1>(textStatus)) reportFatalError = true;
     if (std::get<2>(textStatus))  // Filtered
@@ -386,18 +452,25 @@ bool ErrorContainer::printMessage(Error& error, bool muteStdout) {
     error.m_reported = true;
   }
   bool successLogFile = printToLogFile(report.first);
+  if (report.second) m_logListener->flush();
   return (successLogFile && (!report.second));
 }
 
 bool ErrorContainer::printMessages(bool muteStdout) {
-  std::pair<std::string, bool> report = createReport_();
+  // Only the errors added since the last call, the ones before are either
+  // reported or were muted
+  std::pair<std::string, bool> report = createReport_(m_printedErrors);
   if (!muteStdout) {
     std::cout << report.first << std::flush;
-    for (auto& err : m_errors) {
-      err.m_reported = true;
+    for (size_t i = m_printedErrors; i < m_errors.size(); ++i) {
+      m_errors[i].m_reported = true;
     }
   }
+  m_printedErrors = m_errors.size();
+  if (report.first.empty()) return !report.second;
   bool successLogFile = printToLogFile(report.first);
+  // Fatal errors reach the log file before the caller gives up
+  if (report.second) m_logListener->flush();
   return (successLogFile && (!report.second));
 }
 }  // namespace SURELOG
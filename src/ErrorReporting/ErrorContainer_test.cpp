@@ -0,0 +1,125 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/CommandLine/CommandLineParser.h>
+#include <Surelog/ErrorReporting/ErrorContainer.h>
+#include <Surelog/ErrorReporting/ErrorDefinition.h>
+#include <Surelog/ErrorReporting/Location.h>
+#include <Surelog/ErrorReporting/Waiver.h>
+#include <Surelog/SourceCompile/SymbolTable.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace SURELOG {
+
+namespace {
+TEST(ErrorContainerTest, DeduplicatesOnIdAndLocations) {
+  ErrorDefinition::init();
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  errors.registerCmdLine(&clp);
+
+  const SymbolId file = symbols.registerSymbol("dedup.sv");
+  const SymbolId arg = symbols.registerSymbol("a");
+  Location loc(file, 3, 5, arg);
+  Error error(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT, loc);
+  errors.addError(error);
+  errors.addError(error);
+  EXPECT_EQ(errors.getErrors().size(), 1);
+
+  // A different line, object or extra location is another error
+  Location otherLine(file, 4, 5, arg);
+  Error error2(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT, otherLine);
+  errors.addError(error2);
+  Location otherObject(file, 3, 5, symbols.registerSymbol("b"));
+  Error error3(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT, otherObject);
+  errors.addError(error3);
+  Error error4(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT, loc, otherLine);
+  errors.addError(error4);
+  errors.addError(error4);
+  EXPECT_EQ(errors.getErrors().size(), 4);
+
+  // Unless duplicates are requested
+  errors.addError(error, true);
+  EXPECT_EQ(errors.getErrors().size(), 5);
+
+  // The message is only formatted on demand
+  const std::string text =
+      std::get<0>(errors.createErrorMessage(errors.getErrors()[0], false));
+  EXPECT_NE(text.find("dedup.sv:3:5:"), std::string::npos);
+  EXPECT_NE(text.find("\"a\""), std::string::npos);
+}
+
+TEST(ErrorContainerTest, PrintsOnlyNewMessages) {
+  ErrorDefinition::init();
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  errors.registerCmdLine(&clp);
+
+  const SymbolId file = symbols.registerSymbol("print.sv");
+  Error first(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT,
+              Location(file, 1, 1, 0));
+  errors.addError(first);
+  testing::internal::CaptureStdout();
+  errors.printMessages();
+  EXPECT_NE(testing::internal::GetCapturedStdout().find("print.sv:1:1:"),
+            std::string::npos);
+
+  Error second(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT,
+               Location(file, 2, 1, 0));
+  errors.addError(second);
+  testing::internal::CaptureStdout();
+  errors.printMessages();
+  const std::string output = testing::internal::GetCapturedStdout();
+  EXPECT_EQ(output.find("print.sv:1:1:"), std::string::npos);
+  EXPECT_NE(output.find("print.sv:2:1:"), std::string::npos);
+}
+
+TEST(ErrorContainerTest, WaiversAndFilters) {
+  ErrorDefinition::init();
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  errors.registerCmdLine(&clp);
+
+  Waiver::setWaiver("[WARNI:PP0113]", "waived.sv", 7, "");
+  const SymbolId waived = symbols.registerSymbol("waived.sv");
+  const SymbolId other = symbols.registerSymbol("other.sv");
+  Error onLine(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT,
+               Location(waived, 7, 1, 0));
+  Error offLine(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT,
+                Location(waived, 8, 1, 0));
+  Error otherFile(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT,
+                  Location(other, 7, 1, 0));
+  errors.addError(onLine);
+  EXPECT_EQ(errors.getErrorStats().nbWarning, 0);
+  errors.addError(offLine);
+  errors.addError(otherFile);
+  EXPECT_EQ(errors.getErrors().size(), 3);
+  EXPECT_EQ(errors.getErrorStats().nbWarning, 2);
+
+  // Filtered messages are dropped before being recorded
+  clp.setFilterWarning();
+  Error filtered(ErrorDefinition::PP_MACRO_UNUSED_ARGUMENT,
+                 Location(other, 9, 1, 0));
+  errors.addError(filtered);
+  EXPECT_EQ(errors.getErrors().size(), 3);
+}
+}  // namespace
+}  // namespace SURELOG
@@ -30,6 +30,7 @@
 #include <Surelog/Library/LibrarySet.h>
 #include <Surelog/Library/ParseLibraryDef.h>
 #include <Surelog/Library/SVLibShapeListener.h>
+#include <Surelog/SourceCompile/ByteCharStream.h>
 #include <Surelog/SourceCompile/SymbolTable.h>
 #include <Surelog/Utils/FileUtils.h>
 #include <Surelog/Utils/StringUtils.h>
@@ -38,6 +39,7 @@
 #include <parser/SV3_1aParser.h>
 
 #include <filesystem>
+#include <iterator>
 
 namespace SURELOG {
 
@@ -125,7 +127,14 @@ bool ParseLibraryDef::parseLibraryDefinition(SymbolId fileId, Library* lib) {
 
   AntlrLibParserErrorListener* errorListener =
       new AntlrLibParserErrorListener(this);
-  antlr4::ANTLRInputStream* m_inputStream = new ANTLRInputStream(stream);
+  std::string text((std::istreambuf_iterator<char>(stream)),
+                   std::istreambuf_iterator<char>());
+  stream.close();
+  // ByteCharStream hands the bytes to the lexer as they are: blank out the
+  // non-ASCII ones, as for the source files
+  StringUtils::sanitizeSourceText(text);
+  antlr4::CharStream* m_inputStream =
+      new ByteCharStream(std::move(text), fileName.string());
   SV3_1aLexer* m_lexer = new SV3_1aLexer(m_inputStream);
   m_lexer->removeErrorListeners();
   m_lexer->addErrorListener(errorListener);
@@ -134,8 +134,12 @@ void AnalyzeFile::analyze() {
   bool inConfig = false;
   bool inChecker = false;
   bool inPrimitive = false;
-  // int  inFunction  = false;
-  // int  inTask      = false;
+  bool inFunction = false;
+  bool inTask = false;
+  bool inTypedef = false;
+  int typedefBraces = 0;
+  // import/export statements, up to their ';' (DPI prototypes included)
+  bool inImportExport = false;
   bool inComment = false;
   bool inString = false;
   unsigned int lineNb = 0;
@@ -152,10 +156,17 @@ void AnalyzeFile::analyze() {
   const std::regex import_regex("import[ ]+[a-zA-Z_0-9:\\*]+[ ]*;");
   std::smatch pieces_match;
   std::string fileLevelImportSection;
+  // The file is split between lines, a package item ending on the same line
+  // as the previous chunk is not a split point
+  auto addPackageItem = [&](DesignElement::ElemType type) {
+    if (fileChunks.empty() || (fileChunks.back().m_toLine < lineNb)) {
+      fileChunks.emplace_back(type, startLine, lineNb, startChar, charNb);
+    }
+  };
   // Parse the file
+  // lineNb is the index in allLines, the line number in the file
   for (auto& line : allLines) {
     bool inLineComment = false;
-    lineNb++;
     char c = 0;
     char cp = 0;
     std::string keyword;
@@ -229,52 +240,61 @@ void AnalyzeFile::analyze() {
             }
             inModule--;
           }
-          /*
-          if (keyword == "function" && (prev_keyword != "context") &&
-          (prev_prev_keyword != "import"))
-            {
-              if ((inClass == 0) && (inInterface == 0) && (inModule == 0))
-                {
-                  if (inFunction == false)
-                    {
-                      startLine = lineNb;
-                      startChar = charNb;
-                    }
-                  inFunction = true;
-                }
-            }
-          if (keyword == "endfunction")
-            {
-               if (inFunction == true)
-                 {
-                   FileChunk chunk (DesignElement::ElemType::Function,
-          startLine, lineNb, startChar, charNb); fileChunks.push_back (chunk);
-                   nbFunction++;
-                 }
-              inFunction = false;
+          // Package items (functions, tasks, typedefs) are split points for
+          // the large packages, see the package split below
+          const bool inPackageScope =
+              inPackage && (inClass == 0) && (inModule == 0) &&
+              (inInterface == 0) && !inProgram && !inChecker && !inFunction &&
+              !inTask && !inTypedef;
+          if (keyword == "import" || keyword == "export") {
+            inImportExport = true;
+          }
+          if (keyword == "function" && inPackageScope && !inImportExport &&
+              (prev_keyword != "pure") && (prev_keyword != "with")) {
+            startLine = lineNb;
+            startChar = charNb;
+            inFunction = true;
+          }
+          if (keyword == "endfunction") {
+            if (inFunction) {
+              addPackageItem(DesignElement::ElemType::Function);
             }
-          if (keyword == "task")
-            {
-              if ((inClass == 0) && (inInterface == 0) && (inModule == 0))
-                {
-                  if (inTask == false)
-                    {
-                      startLine = lineNb;
-                      startChar = charNb;
-                    }
-                  inTask = true;
-                }
+            inFunction = false;
+          }
+          if (keyword == "task" && inPackageScope && !inImportExport) {
+            startLine = lineNb;
+            startChar = charNb;
+            inTask = true;
+          }
+          if (keyword == "endtask") {
+            if (inTask) {
+              addPackageItem(DesignElement::ElemType::Task);
             }
-          if (keyword == "endtask")
-            {
-               if (inTask == true)
-                 {
-                   FileChunk chunk (DesignElement::ElemType::Task, startLine,
-          lineNb, startChar, charNb); fileChunks.push_back (chunk); nbTask++;
-                 }
-              inTask = false;
+            inTask = false;
+          }
+          if (keyword == "typedef" && inPackageScope) {
+            startLine = lineNb;
+            startChar = charNb;
+            inTypedef = true;
+            typedefBraces = 0;
+          }
+          if (inTypedef) {
+            if (c == '{') {
+              typedefBraces++;
+            } else if (c == '}') {
+              typedefBraces--;
+            } else if ((c == ';') && (typedefBraces == 0)) {
+              addPackageItem(DesignElement::ElemType::Typedef);
+              inTypedef = false;
             }
-           */
+          }
+          if (c == ';') {
+            inImportExport = false;
+          }
+          if (keyword == "class" && (prev_keyword == "interface")) {
+            // interface class, not an interface
+            inInterface--;
+          }
           if (keyword == "class" && (prev_keyword != "typedef")) {
             if (inClass == 0) {
               startLine = lineNb;
@@ -290,7 +310,7 @@ void AnalyzeFile::analyze() {
             }
             inClass--;
           }
-          if (keyword == "interface") {
+          if (keyword == "interface" && (prev_keyword != "virtual")) {
             if (inInterface == 0) {
               startLine = lineNb;
               startChar = charNb;
@@ -376,6 +396,7 @@ void AnalyzeFile::analyze() {
         fileLevelImportSection += line;
       }
     }
+    lineNb++;
   }
 
   unsigned int lineSize = lineNb;
@@ -441,7 +462,6 @@ void AnalyzeFile::analyze() {
       if ((fileChunks[i].m_toLine - fileChunks[i].m_fromLine) > chunkSize) {
         bool splitted = false;
         bool endPackageDetected = false;
-        std::string sllineInfo;
         unsigned int origFromLine = 0;
         fs::path origFile;
         // unsigned int baseFromLine = fromLine;
@@ -479,14 +499,10 @@ void AnalyzeFile::analyze() {
             toLine = allLines.size();
           }
 
+          // The package context goes on the first line of the next pieces
+          content = setSLlineDirective_(fromLine, origFromLine, origFile);
           if (splitted) {
-            content += sllineInfo;
             content += packageDeclaration + "  " + importSection;
-            // content += "SLline " + std::to_string(fromLine - baseFromLine +
-            // origFromLine + 1) + " \"" + origFile + "\" 1";
-          } else {
-            sllineInfo = setSLlineDirective_(fromLine, origFromLine, origFile);
-            content = sllineInfo;
           }
 
           bool inString = false;
@@ -0,0 +1,233 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/CommandLine/CommandLineParser.h>
+#include <Surelog/Design/Design.h>
+#include <Surelog/ErrorReporting/ErrorContainer.h>
+#include <Surelog/SourceCompile/AnalyzeFile.h>
+#include <Surelog/SourceCompile/SymbolTable.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+struct Piece {
+  std::string content;
+  unsigned int lineOffset;
+};
+
+// Splits text in (up to) nbChunks pieces, whatever its number of lines
+std::vector<Piece> split(std::string_view text, int nbChunks) {
+  const fs::path dir = fs::temp_directory_path() / "surelog_analyze_test";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  clp.setNbLinesForFileSpliting(1);
+  Design design(&errors, nullptr, nullptr);
+  AnalyzeFile analyzer(&clp, &design, dir / "file.sv", "orig.sv", nbChunks,
+                       std::string(text));
+  analyzer.analyze();
+
+  std::vector<Piece> pieces;
+  for (unsigned int i = 0; i < analyzer.getSplitFiles().size(); i++) {
+    std::ifstream ifs(analyzer.getSplitFiles()[i]);
+    std::stringstream content;
+    content << ifs.rdbuf();
+    pieces.push_back({content.str(), analyzer.getLineOffsets()[i]});
+  }
+  fs::remove_all(dir);
+  return pieces;
+}
+
+std::string firstLine(const std::string& content) {
+  return content.substr(0, content.find('\n'));
+}
+
+// Line of the piece after its SLline directive
+std::string secondLine(const std::string& content) {
+  const size_t start = content.find('\n') + 1;
+  return content.substr(start, content.find('\n', start) - start);
+}
+
+// Original line nb (1-based) to the line text
+std::string line(std::string_view text, unsigned int lineNb) {
+  std::stringstream ss{std::string(text)};
+  std::string result;
+  for (unsigned int i = 0; i < lineNb; i++) std::getline(ss, result);
+  return result;
+}
+
+TEST(AnalyzeFileTest, SplitsPackageAtFunctionBoundaries) {
+  constexpr std::string_view kText = R"(package pkg;
+  typedef struct {
+    int a;
+  } s_t;
+  function int f1();
+    return 1;
+  endfunction
+  task t1();
+  endtask
+  function int f2();
+    return 2;
+  endfunction
+  typedef enum {A, B} e_t;
+  function int f3();
+    return 3;
+  endfunction
+endpackage
+)";
+  const std::vector<Piece> pieces = split(kText, 2);
+  ASSERT_EQ(pieces.size(), 2);
+  EXPECT_EQ(pieces[0].lineOffset, 0);
+  EXPECT_EQ(firstLine(pieces[0].content), "SLline 1 \"orig.sv\" 1");
+  // The first piece ends with a function, not in the middle of the next item
+  EXPECT_NE(pieces[0].content.find("endfunction  endpackage"),
+            std::string::npos);
+  EXPECT_EQ(pieces[0].content.find("typedef enum"), std::string::npos);
+  // The first line of the next item is the first line of the next piece,
+  // after the package context
+  EXPECT_EQ(pieces[1].lineOffset, 12);
+  EXPECT_EQ(firstLine(pieces[1].content), "SLline 13 \"orig.sv\" 1");
+  EXPECT_EQ(secondLine(pieces[1].content),
+            "package pkg;  " + line(kText, 13));
+}
+
+TEST(AnalyzeFileTest, SplitsPackageAtTypedefBoundaries) {
+  constexpr std::string_view kText = R"(package pkg;
+  typedef int t1;
+  typedef int t2;
+  typedef struct {
+    int a;
+  } t3;
+  typedef int t4;
+  typedef int t5;
+endpackage
+)";
+  const std::vector<Piece> pieces = split(kText, 3);
+  ASSERT_EQ(pieces.size(), 2);
+  // The struct typedef is not cut at its inner ';'
+  EXPECT_NE(pieces[0].content.find(
+                "typedef struct {\n    int a;\n  } t3;  endpackage"),
+            std::string::npos);
+  EXPECT_EQ(pieces[1].lineOffset, 6);
+  EXPECT_EQ(firstLine(pieces[1].content), "SLline 7 \"orig.sv\" 1");
+  EXPECT_EQ(secondLine(pieces[1].content),
+            "package pkg;  " + line(kText, 7));
+}
+
+TEST(AnalyzeFileTest, SLlineOfEachPiece) {
+  constexpr std::string_view kText = R"(package pkg;
+  function int f1();
+    return 1;
+  endfunction
+  function int f2();
+    return 2;
+  endfunction
+  function int f3();
+    return 3;
+  endfunction
+  function int f4();
+    return 4;
+  endfunction
+endpackage
+)";
+  const std::vector<Piece> pieces = split(kText, 4);
+  const std::vector<unsigned int> firstLines = {1, 5, 11};
+  ASSERT_EQ(pieces.size(), firstLines.size());
+  for (unsigned int i = 0; i < pieces.size(); i++) {
+    // Each piece points back to its own first line
+    EXPECT_EQ(firstLine(pieces[i].content),
+              "SLline " + std::to_string(firstLines[i]) + " \"orig.sv\" 1");
+    EXPECT_EQ(pieces[i].lineOffset, firstLines[i] - 1);
+    EXPECT_NE(secondLine(pieces[i].content).find(line(kText, firstLines[i])),
+              std::string::npos);
+  }
+}
+
+TEST(AnalyzeFileTest, VirtualInterfaceAndInterfaceClass) {
+  constexpr std::string_view kText = R"(interface class ic;
+endclass
+package pkg;
+  virtual interface bus_if vif;
+  function int f1();
+    return 1;
+  endfunction
+  function int f2();
+    return 2;
+  endfunction
+endpackage
+)";
+  // Neither is an interface left open, the package is still split
+  const std::vector<Piece> pieces = split(kText, 3);
+  ASSERT_EQ(pieces.size(), 3);
+  EXPECT_NE(pieces[0].content.find("endclass"), std::string::npos);
+  EXPECT_EQ(firstLine(pieces[1].content), "SLline 3 \"orig.sv\" 1");
+  EXPECT_NE(pieces[1].content.find("virtual interface bus_if vif;"),
+            std::string::npos);
+  EXPECT_EQ(firstLine(pieces[2].content), "SLline 8 \"orig.sv\" 1");
+}
+
+TEST(AnalyzeFileTest, DPIPrototypes) {
+  constexpr std::string_view kText = R"(package pkg;
+  import "DPI-C" c_add = function int add(int a, int b);
+  export "DPI-C" c_f = function f;
+  import "DPI-C" context task c_t();
+  typedef int t1;
+  typedef int t2;
+  typedef int t3;
+  typedef int t4;
+  function int f();
+    return 1;
+  endfunction
+endpackage
+)";
+  // The prototypes are not the start of a function (or task) extending to
+  // the next endfunction, the typedefs are split points
+  const std::vector<Piece> pieces = split(kText, 4);
+  ASSERT_EQ(pieces.size(), 2);
+  EXPECT_NE(pieces[0].content.find("typedef int t1;  endpackage"),
+            std::string::npos);
+  EXPECT_EQ(firstLine(pieces[1].content), "SLline 6 \"orig.sv\" 1");
+  EXPECT_EQ(secondLine(pieces[1].content),
+            "package pkg;  " + line(kText, 6));
+}
+
+TEST(AnalyzeFileTest, SmallFileIsNotSplit) {
+  constexpr std::string_view kText = R"(package pkg;
+  function int f1();
+    return 1;
+  endfunction
+endpackage
+)";
+  // The preprocessed file is parsed as is
+  const std::vector<Piece> pieces = split(kText, 1);
+  ASSERT_EQ(pieces.size(), 1);
+  EXPECT_EQ(pieces[0].lineOffset, 0);
+}
+}  // namespace
+}  // namespace SURELOG
@@ -24,6 +24,7 @@
 
 #include <Surelog/SourceCompile/AntlrParserErrorListener.h>
 #include <Surelog/SourceCompile/AntlrParserHandler.h>
+#include <Surelog/SourceCompile/SV3_1aFastLexer.h>
 #include <parser/SV3_1aLexer.h>
 #include <parser/SV3_1aParser.h>
 
@@ -36,6 +37,7 @@ AntlrParserHandler::~AntlrParserHandler() {
   delete m_parser;
   delete m_tokens;
   delete m_lexer;
+  delete m_fastLexer;
   delete m_inputStream;
 }
 }  // namespace SURELOG
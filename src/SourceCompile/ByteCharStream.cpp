@@ -0,0 +1,74 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Exceptions.h>
+#include <Surelog/SourceCompile/ByteCharStream.h>
+#include <misc/Interval.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace SURELOG {
+
+static std::string_view skipByteOrderMark(std::string_view text) {
+  constexpr std::string_view bom = "\xef\xbb\xbf";
+  if (text.compare(0, bom.size(), bom) == 0) text.remove_prefix(bom.size());
+  return text;
+}
+
+ByteCharStream::ByteCharStream(std::string text, std::string_view sourceName)
+    : m_text(std::move(text)),
+      m_data(skipByteOrderMark(m_text)),
+      m_sourceName(sourceName) {}
+
+void ByteCharStream::consume() {
+  if (m_index >= m_data.size()) {
+    throw antlr4::IllegalStateException("cannot consume EOF");
+  }
+  ++m_index;
+}
+
+size_t ByteCharStream::LA(ssize_t i) {
+  if (i == 0) return 0;  // undefined
+  // LA(1) is the current character, LA(-1) the previous one
+  const ssize_t position =
+      static_cast<ssize_t>(m_index) + ((i > 0) ? i - 1 : i);
+  if ((position < 0) || (position >= static_cast<ssize_t>(m_data.size()))) {
+    return antlr4::IntStream::EOF;
+  }
+  return static_cast<unsigned char>(m_data[position]);
+}
+
+void ByteCharStream::seek(size_t index) {
+  m_index = std::min(index, m_data.size());
+}
+
+std::string ByteCharStream::getSourceName() const {
+  if (m_sourceName.empty()) return antlr4::IntStream::UNKNOWN_SOURCE_NAME;
+  return m_sourceName;
+}
+
+std::string ByteCharStream::getText(const antlr4::misc::Interval& interval) {
+  if ((interval.a < 0) || (interval.b < 0)) return "";
+  const size_t start = static_cast<size_t>(interval.a);
+  if (start >= m_data.size()) return "";
+  const size_t stop =
+      std::min(static_cast<size_t>(interval.b), m_data.size() - 1);
+  if (stop < start) return "";
+  return std::string(m_data.substr(start, stop - start + 1));
+}
+
+}  // namespace SURELOG
@@ -0,0 +1,62 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/ByteCharStream.h>
+#include <antlr4-runtime.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace SURELOG {
+
+namespace {
+TEST(ByteCharStreamTest, LookAheadAndConsume) {
+  ByteCharStream stream("ab\xe9", "test.sv");
+  EXPECT_EQ(stream.size(), size_t(3));
+  EXPECT_EQ(stream.getSourceName(), "test.sv");
+  EXPECT_EQ(stream.LA(1), size_t('a'));
+  EXPECT_EQ(stream.LA(2), size_t('b'));
+  EXPECT_EQ(stream.LA(3), size_t(0xe9));  // Bytes are not decoded
+  EXPECT_EQ(stream.LA(4), size_t(antlr4::IntStream::EOF));
+  EXPECT_EQ(stream.LA(-1), size_t(antlr4::IntStream::EOF));
+  stream.consume();
+  EXPECT_EQ(stream.index(), size_t(1));
+  EXPECT_EQ(stream.LA(-1), size_t('a'));
+  EXPECT_EQ(stream.LA(1), size_t('b'));
+  stream.seek(10);
+  EXPECT_EQ(stream.index(), size_t(3));
+  EXPECT_EQ(stream.LA(1), size_t(antlr4::IntStream::EOF));
+  EXPECT_THROW(stream.consume(), antlr4::IllegalStateException);
+}
+
+TEST(ByteCharStreamTest, GetText) {
+  ByteCharStream stream("module top;");
+  EXPECT_EQ(stream.getSourceName(), antlr4::IntStream::UNKNOWN_SOURCE_NAME);
+  using antlr4::misc::Interval;
+  EXPECT_EQ(stream.getText(Interval(size_t(0), size_t(5))), "module");
+  EXPECT_EQ(stream.getText(Interval(size_t(7), size_t(100))), "top;");
+  EXPECT_EQ(stream.getText(Interval(size_t(5), size_t(4))), "");
+  EXPECT_EQ(stream.toString(), "module top;");
+}
+
+TEST(ByteCharStreamTest, ByteOrderMark) {
+  ByteCharStream stream("\xef\xbb\xbfmodule");
+  EXPECT_EQ(stream.size(), size_t(6));
+  EXPECT_EQ(stream.LA(1), size_t('m'));
+  EXPECT_EQ(stream.toString(), "module");
+}
+}  // namespace
+}  // namespace SURELOG
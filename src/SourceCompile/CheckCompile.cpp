@@ -54,6 +54,8 @@ bool CheckCompile::mergeSymbolTables_() {
       m_compiler->getDesign()->getAllFileContents();
   for (auto fitr = all_files.begin(); fitr != all_files.end(); fitr++) {
     auto fileContent = (*fitr).second;
+    // Files parsed with the shared table already hold compiler ids
+    if (fileContent->getSymbolTable() == m_compiler->getSymbolTable()) continue;
     m_compiler->getSymbolTable()->registerSymbol(
         fileContent->getFileName().string());
     for (NodeId id : fileContent->getNodeIds()) {
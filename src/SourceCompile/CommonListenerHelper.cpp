@@ -26,10 +26,23 @@
 #include <Surelog/SourceCompile/CommonListenerHelper.h>
 #include <antlr4-runtime.h>
 
+#include <atomic>
+
 namespace SURELOG {
 
 using namespace antlr4;
 
+static uint64_t nextWalkTag() {
+  static std::atomic<uint32_t> walkCount(0);
+  return static_cast<uint64_t>(++walkCount) << 32;
+}
+
+CommonListenerHelper::CommonListenerHelper(FileContent* file_content,
+                                           CommonTokenStream* tokens)
+    : m_fileContent(file_content),
+      m_tokens(tokens),
+      m_walkTag(nextWalkTag()) {}
+
 CommonListenerHelper::~CommonListenerHelper() {
   // TODO: ownership not clear
   // delete m_fileContent;
@@ -46,8 +59,9 @@ int CommonListenerHelper::LastObjIndex() {
 
 int CommonListenerHelper::ObjectIndexFromContext(
     const antlr4::tree::ParseTree* ctx) const {
-  auto found = m_contextToObjectMap.find(ctx);
-  return (found == m_contextToObjectMap.end()) ? -1 : found->second;
+  const uint64_t data = ctx->listenerData;
+  if ((data & 0xFFFFFFFF00000000ULL) != m_walkTag) return -1;
+  return static_cast<int>(data & 0xFFFFFFFFULL);
 }
 
 VObject& CommonListenerHelper::Object(NodeId index) {
@@ -96,18 +110,18 @@ int CommonListenerHelper::addVObject(ParserRuleContext* ctx, SymbolId sym,
   m_fileContent->getVObjects().emplace_back(sym, fileId, objtype, line, column,
                                             endLine, endColumn, 0);
   int objectIndex = m_fileContent->getVObjects().size() - 1;
-  m_contextToObjectMap.insert(std::make_pair(ctx, objectIndex));
+  ctx->listenerData = m_walkTag | static_cast<uint32_t>(objectIndex);
   addParentChildRelations(objectIndex, ctx);
-  std::vector<SURELOG::DesignElement*>& delements =
-      m_fileContent->getDesignElements();
-  for (auto it = delements.rbegin(); it != delements.rend(); ++it) {
-    if ((*it)->m_context == ctx) {
+  if (!m_contextToElementMap.empty()) {
+    auto found = m_contextToElementMap.find(ctx);
+    if (found != m_contextToElementMap.end()) {
       // Use the file and line number of the design object (package, module),
       // true file/line when splitting
-      m_fileContent->getVObjects().back().m_fileId = (*it)->m_fileId;
-      m_fileContent->getVObjects().back().m_line = (*it)->m_line;
-      (*it)->m_node = objectIndex;
-      break;
+      DesignElement* const elem = found->second;
+      m_fileContent->getVObjects().back().m_fileId = elem->m_fileId;
+      m_fileContent->getVObjects().back().m_line = elem->m_line;
+      elem->m_node = objectIndex;
+      m_contextToElementMap.erase(found);
     }
   }
   return objectIndex;
@@ -142,12 +156,12 @@ void CommonListenerHelper::addParentChildRelations(int indexParent,
 }
 
 NodeId CommonListenerHelper::getObjectId(ParserRuleContext* ctx) {
-  ContextToObjectMap::iterator itr = m_contextToObjectMap.find(ctx);
-  if (itr == m_contextToObjectMap.end()) {
-    return 0;
-  } else {
-    return (*itr).second;
-  }
+  const int index = ObjectIndexFromContext(ctx);
+  return (index == -1) ? 0 : index;
+}
+
+void CommonListenerHelper::aliasContext(tree::ParseTree* ctx, NodeId index) {
+  ctx->listenerData = m_walkTag | index;
 }
 
 }  // namespace SURELOG
@@ -22,6 +22,8 @@
  */
 #include <Surelog/SourceCompile/CompilationUnit.h>
 
+#include <algorithm>
+
 namespace SURELOG {
 
 CompilationUnit::CompilationUnit(bool fileunit)
@@ -32,72 +34,86 @@ CompilationUnit::CompilationUnit(bool fileunit)
 
 CompilationUnit::~CompilationUnit() {}
 
-MacroInfo* CompilationUnit::getMacroInfo(const std::string& macroName) {
-  MacroStorageRef::iterator itr = m_macros.find(macroName);
-  if (itr != m_macros.end()) {
-    return (*itr).second;
-  }
-  return nullptr;
+MacroInfo* CompilationUnit::getMacroInfo(std::string_view macroName) const {
+  const SymbolId id = m_macroNames.getId(macroName);
+  if (id == SymbolTable::getBadId()) return nullptr;
+  return m_macros.find(id);
 }
 
-void CompilationUnit::registerMacroInfo(const std::string& macroName,
+void CompilationUnit::registerMacroInfo(std::string_view macroName,
                                         MacroInfo* macro) {
-  m_macros.insert(MacroStorageRef::value_type(macroName, macro));
+  m_macros.insert(m_macroNames.registerSymbol(macroName), macro);
 }
 
-void CompilationUnit::deleteMacro(const std::string& macroName) {
-  MacroStorageRef::iterator itr = m_macros.find(macroName);
-  if (itr != m_macros.end()) {
-    m_macros.erase(itr);
-  }
+void CompilationUnit::deleteMacro(std::string_view macroName) {
+  const SymbolId id = m_macroNames.getId(macroName);
+  if (id != SymbolTable::getBadId()) m_macros.erase(id);
+}
+
+void CompilationUnit::indexRecord_(LineIndex& index, unsigned int line,
+                                   unsigned int record) {
+  // The new record is the latest: it applies from its line on, whatever
+  // was recorded before for the lines after it
+  const size_t position =
+      std::upper_bound(index.m_lines.begin(), index.m_lines.end(), line) -
+      index.m_lines.begin();
+  index.m_lines.insert(index.m_lines.begin() + position, line);
+  index.m_records.insert(index.m_records.begin() + position, record);
+  std::fill(index.m_records.begin() + position, index.m_records.end(),
+            record);
+}
+
+int CompilationUnit::findRecord_(const LineIndex& index, unsigned int line) {
+  const size_t position =
+      std::upper_bound(index.m_lines.begin(), index.m_lines.end(), line) -
+      index.m_lines.begin();
+  return (position == 0) ? -1 : index.m_records[position - 1];
 }
 
 void CompilationUnit::recordTimeInfo(TimeInfo& info) {
+  std::lock_guard<std::mutex> lock(m_infoMutex);
+  indexRecord_(m_timeInfoIndex[info.m_fileId], info.m_line,
+               m_timeInfo.size());
   m_timeInfo.push_back(info);
 }
 
-TimeInfo& CompilationUnit::getTimeInfo(SymbolId fileId, unsigned int line) {
-  if (m_timeInfo.empty()) {
+TimeInfo CompilationUnit::getTimeInfo(SymbolId fileId, unsigned int line) {
+  std::lock_guard<std::mutex> lock(m_infoMutex);
+  auto found = m_timeInfoIndex.find(fileId);
+  if (found == m_timeInfoIndex.end()) {
     return m_noTimeInfo;
   }
-  for (int i = (int)m_timeInfo.size() - 1; i >= 0; i--) {
-    TimeInfo& info = m_timeInfo[i];
-    if (info.m_fileId == fileId) {
-      if (line >= info.m_line) {
-        return info;
-      }
-    }
-  }
-  return m_noTimeInfo;
+  const int record = findRecord_(found->second, line);
+  return (record == -1) ? m_noTimeInfo : m_timeInfo[record];
 }
 
 void CompilationUnit::recordDefaultNetType(NetTypeInfo& info) {
+  std::lock_guard<std::mutex> lock(m_infoMutex);
+  indexRecord_(m_defaultNetTypeIndex[info.m_fileId], info.m_line,
+               m_defaultNetTypes.size());
   m_defaultNetTypes.push_back(info);
 }
 
 VObjectType CompilationUnit::getDefaultNetType(SymbolId fileId,
                                                unsigned int line) {
-  if (m_defaultNetTypes.empty()) {
+  std::lock_guard<std::mutex> lock(m_infoMutex);
+  auto found = m_defaultNetTypeIndex.find(fileId);
+  if (found == m_defaultNetTypeIndex.end()) {
     return slNetType_Wire;
   }
-  for (int i = (int)m_defaultNetTypes.size() - 1; i >= 0; i--) {
-    NetTypeInfo& info = m_defaultNetTypes[i];
-    if (info.m_fileId == fileId) {
-      if (line >= info.m_line) {
-        return info.m_type;
-      }
-    }
-  }
-  return slNetType_Wire;
+  const int record = findRecord_(found->second, line);
+  return (record == -1) ? slNetType_Wire : m_defaultNetTypes[record].m_type;
 }
 
 void CompilationUnit::setCurrentTimeInfo(SymbolId fileId) {
+  std::lock_guard<std::mutex> lock(m_infoMutex);
   if (m_timeInfo.empty()) {
     return;
   }
   TimeInfo info = m_timeInfo[m_timeInfo.size() - 1];
   info.m_fileId = fileId;
   info.m_line = 1;
+  indexRecord_(m_timeInfoIndex[fileId], info.m_line, m_timeInfo.size());
   m_timeInfo.push_back(info);
 }
 
@@ -0,0 +1,117 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/Design/TimeInfo.h>
+#include <Surelog/SourceCompile/CompilationUnit.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+// The latest record of the file at or before the line
+int latestRecord(const std::vector<TimeInfo>& records, SymbolId fileId,
+                 unsigned int line) {
+  for (int i = (int)records.size() - 1; i >= 0; i--) {
+    if ((records[i].m_fileId == fileId) && (line >= records[i].m_line)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+TEST(CompilationUnitTest, TimeInfoLookup) {
+  CompilationUnit unit(true);
+  EXPECT_EQ(unit.getTimeInfo(1, 10).m_type, TimeInfo::Type::None);
+
+  std::mt19937 random(7);
+  std::uniform_int_distribution<unsigned int> pickFile(1, 5);
+  std::uniform_int_distribution<unsigned int> pickLine(1, 200);
+  for (int i = 0; i < 500; ++i) {
+    // Mostly in line order, as a file is walked, sometimes not
+    TimeInfo info;
+    info.m_type = TimeInfo::Type::Timescale;
+    info.m_fileId = pickFile(random);
+    info.m_line = (i % 7) ? (i / 3) : pickLine(random);
+    info.m_timeUnitValue = i;
+    unit.recordTimeInfo(info);
+    if (i % 50 == 0) unit.setCurrentTimeInfo(pickFile(random));
+
+    for (int q = 0; q < 20; ++q) {
+      const SymbolId fileId = pickFile(random);
+      const unsigned int line = pickLine(random);
+      const int expected = latestRecord(unit.getTimeInfo(), fileId, line);
+      const TimeInfo found = unit.getTimeInfo(fileId, line);
+      if (expected == -1) {
+        EXPECT_EQ(found.m_type, TimeInfo::Type::None);
+      } else {
+        EXPECT_EQ(found.m_timeUnitValue,
+                  unit.getTimeInfo()[expected].m_timeUnitValue);
+        EXPECT_EQ(found.m_fileId, fileId);
+      }
+    }
+  }
+}
+
+TEST(CompilationUnitTest, DefaultNetTypeLookup) {
+  CompilationUnit unit(true);
+  NetTypeInfo none;
+  none.m_type = slNoType;
+  none.m_fileId = 3;
+  none.m_line = 10;
+  unit.recordDefaultNetType(none);
+  NetTypeInfo wire;
+  wire.m_type = slNetType_Wire;
+  wire.m_fileId = 3;
+  wire.m_line = 20;
+  unit.recordDefaultNetType(wire);
+
+  EXPECT_EQ(unit.getDefaultNetType(3, 5), slNetType_Wire);
+  EXPECT_EQ(unit.getDefaultNetType(3, 10), slNoType);
+  EXPECT_EQ(unit.getDefaultNetType(3, 19), slNoType);
+  EXPECT_EQ(unit.getDefaultNetType(3, 25), slNetType_Wire);
+  EXPECT_EQ(unit.getDefaultNetType(4, 15), slNetType_Wire);
+}
+
+// 100k `timescale records over 1000 files (-fileunit vendor libraries),
+// then a lookup for each
+TEST(CompilationUnitTest, TimeInfoManyFiles) {
+  constexpr unsigned int kRecords = 100000;
+  constexpr unsigned int kFiles = 1000;
+  CompilationUnit unit(true);
+  for (unsigned int i = 0; i < kRecords; ++i) {
+    TimeInfo info;
+    info.m_type = TimeInfo::Type::Timescale;
+    info.m_fileId = 1 + (i / (kRecords / kFiles));
+    info.m_line = 1 + 10 * (i % (kRecords / kFiles));
+    unit.recordTimeInfo(info);
+  }
+  unsigned int found = 0;
+  for (unsigned int i = 0; i < kRecords; ++i) {
+    const SymbolId fileId = 1 + (i % kFiles);
+    const unsigned int line = 5 + 10 * (i % 100);
+    const TimeInfo info = unit.getTimeInfo(fileId, line);
+    if ((info.m_type == TimeInfo::Type::Timescale) &&
+        (info.m_fileId == fileId) && (info.m_line == line - 4)) {
+      ++found;
+    }
+  }
+  EXPECT_EQ(found, kRecords);
+}
+}  // namespace
+}  // namespace SURELOG
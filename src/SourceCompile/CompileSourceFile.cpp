@@ -251,9 +251,9 @@ bool CompileSourceFile::postPreprocess_() {
         m_symbolTable->registerSymbol(symbolTable->getSymbol(m_fileId));
     return true;
   }
-  std::string m_pp_result = m_pp->getPreProcessedFileContent();
+  const PPOutputBuffer& ppResult = m_pp->getPreProcessedOutput();
   if (!m_text.empty()) {
-    m_parser = new ParseFile(m_pp_result, this, m_compilationUnit,
+    m_parser = new ParseFile(ppResult.str(), this, m_compilationUnit,
                              m_library);  // unit test
   }
   if (m_commandLineParser->writePpOutput() ||
@@ -291,7 +291,7 @@ bool CompileSourceFile::postPreprocess_() {
       std::ofstream ofs;
       ofs.open(ppFileName);
       if (ofs.good()) {
-        ofs << m_pp_result;
+        ppResult.write(ofs);
         ofs.close();
       } else {
         Location loc(ppOutId);
@@ -22,12 +22,14 @@
  */
 
 #include <Surelog/API/PythonAPI.h>
+#include <Surelog/Cache/DFACache.h>
 #include <Surelog/CommandLine/CommandLineParser.h>
 #include <Surelog/Config/ConfigSet.h>
 #include <Surelog/Design/Design.h>
 #include <Surelog/Design/FileContent.h>
 #include <Surelog/DesignCompile/Builtin.h>
 #include <Surelog/DesignCompile/CompileDesign.h>
+#include <Surelog/ErrorReporting/ErrorContainer.h>
 #include <Surelog/Library/Library.h>
 #include <Surelog/Library/LibrarySet.h>
 #include <Surelog/Library/ParseLibraryDef.h>
@@ -44,7 +46,13 @@
 #include <Surelog/Utils/StringUtils.h>
 #include <Surelog/Utils/Timer.h>
 #include <antlr4-runtime.h>
+#include <parser/SV3_1aLexer.h>
+#include <parser/SV3_1aParser.h>
+#include <parser/SV3_1aPpLexer.h>
+#include <parser/SV3_1aPpParser.h>
 
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #if defined(_MSC_VER)
@@ -54,6 +62,10 @@
 #include <unistd.h>
 #endif
 
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
 namespace SURELOG {
 
 namespace fs = std::filesystem;
@@ -125,6 +137,28 @@ struct FunctorCompileOneFile {
   CompileSourceFile::Action m_action;
 };
 
+// Peak resident set size of the process in MB, 0 when unknown
+static uint64_t peakMemoryMB() {
+#if defined(_WIN32)
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss / (1024 * 1024);  // Bytes
+#else
+  return usage.ru_maxrss / 1024;  // Kilobytes
+#endif
+#endif
+}
+
+// " (peak memory N MB)" for the -profile messages
+static std::string peakMemoryInfo() {
+  const uint64_t peak = peakMemoryMB();
+  if (peak == 0) return "";
+  return " (peak memory " + std::to_string(peak) + " MB)";
+}
+
 bool Compiler::compileOneFile_(CompileSourceFile* compiler,
                                CompileSourceFile::Action action) {
   bool status = compiler->compile(action);
@@ -151,7 +185,6 @@ bool Compiler::ppinit_() {
   std::set<fs::path> sourceFileNames;
   unsigned int size = m_commandLineParser->getSourceFiles().size();
   for (const SymbolId source_file_id : m_commandLineParser->getSourceFiles()) {
-    SymbolTable* symbols = m_symbolTable;
     if (m_commandLineParser->fileunit()) {
       comp_unit = new CompilationUnit(true);
       if (m_commandLineParser->parseBuiltIn()) {
@@ -159,10 +192,8 @@ bool Compiler::ppinit_() {
         builtin->addBuiltinMacros(comp_unit);
       }
       m_compilationUnits.push_back(comp_unit);
-      symbols = new SymbolTable(m_commandLineParser->getSymbolTable());
-      m_symbolTables.push_back(symbols);
     }
-    ErrorContainer* errors = new ErrorContainer(symbols);
+    ErrorContainer* errors = new ErrorContainer(m_symbolTable);
     m_errorContainers.push_back(errors);
     errors->registerCmdLine(m_commandLineParser);
 
@@ -178,7 +209,7 @@ bool Compiler::ppinit_() {
 
     CompileSourceFile* compiler =
         new CompileSourceFile(source_file_id, m_commandLineParser, errors, this,
-                              symbols, comp_unit, library);
+                              m_symbolTable, comp_unit, library);
     m_compilers.push_back(compiler);
   }
 
@@ -219,14 +250,11 @@ bool Compiler::ppinit_() {
     }
   }
   for (auto id : libFiles) {
-    SymbolTable* symbols = m_symbolTable;
     if (m_commandLineParser->fileunit()) {
       comp_unit = new CompilationUnit(true);
       m_compilationUnits.push_back(comp_unit);
-      symbols = new SymbolTable(m_commandLineParser->getSymbolTable());
-      m_symbolTables.push_back(symbols);
     }
-    ErrorContainer* errors = new ErrorContainer(symbols);
+    ErrorContainer* errors = new ErrorContainer(m_symbolTable);
     m_errorContainers.push_back(errors);
     errors->registerCmdLine(m_commandLineParser);
 
@@ -263,19 +291,17 @@ bool Compiler::ppinit_() {
         // .map files are not parsed with the regular parser
         continue;
       }
-      SymbolTable* symbols = m_symbolTable;
       if (m_commandLineParser->fileunit()) {
         comp_unit = new CompilationUnit(true);
         m_compilationUnits.push_back(comp_unit);
-        symbols = new SymbolTable(m_commandLineParser->getSymbolTable());
-        m_symbolTables.push_back(symbols);
       }
-      ErrorContainer* errors = new ErrorContainer(symbols);
+      ErrorContainer* errors = new ErrorContainer(m_symbolTable);
       m_errorContainers.push_back(errors);
       errors->registerCmdLine(m_commandLineParser);
 
       CompileSourceFile* compiler = new CompileSourceFile(
-          id, m_commandLineParser, errors, this, symbols, comp_unit, &lib);
+          id, m_commandLineParser, errors, this, m_symbolTable, comp_unit,
+          &lib);
       m_compilers.push_back(compiler);
     }
   }
@@ -661,7 +687,6 @@ bool Compiler::parseinit_() {
   // Large files are going to be compiled in a different batch in multithread
 
   if (!m_commandLineParser->fileunit()) {
-    DeleteContainerPointersAndClear(&m_symbolTables);
     DeleteContainerPointersAndClear(&m_errorContainers);
   }
 
@@ -689,12 +714,7 @@ bool Compiler::parseinit_() {
       compiler->initParser();
 
       if (!m_commandLineParser->fileunit()) {
-        SymbolTable* symbols =
-            new SymbolTable(m_commandLineParser->getSymbolTable());
-        m_symbolTables.push_back(symbols);
-        compiler->setSymbolTable(symbols);
-        // fileContent->setSymbolTable(symbols);
-        ErrorContainer* errors = new ErrorContainer(symbols);
+        ErrorContainer* errors = new ErrorContainer(m_symbolTable);
         m_errorContainers.push_back(errors);
         errors->registerCmdLine(m_commandLineParser);
         compiler->setErrorContainer(errors);
@@ -707,19 +727,14 @@ bool Compiler::parseinit_() {
 
       int j = 0;
       for (auto& chunk : fileAnalyzer->getSplitFiles()) {
-        SymbolTable* symbols =
-            new SymbolTable(m_commandLineParser->getSymbolTable());
-        m_symbolTables.push_back(symbols);
-        SymbolId ppId = symbols->registerSymbol(chunk.string());
-        symbols->registerSymbol(
-            compiler->getParser()->getFileName(LINE1).string());
+        SymbolId ppId = m_symbolTable->registerSymbol(chunk.string());
         CompileSourceFile* chunkCompiler = new CompileSourceFile(
             compiler, ppId, fileAnalyzer->getLineOffsets()[j]);
         // Schedule chunk
         tmp_compilers.push_back(chunkCompiler);
 
-        chunkCompiler->setSymbolTable(symbols);
-        ErrorContainer* errors = new ErrorContainer(symbols);
+        chunkCompiler->setSymbolTable(m_symbolTable);
+        ErrorContainer* errors = new ErrorContainer(m_symbolTable);
         m_errorContainers.push_back(errors);
         errors->registerCmdLine(m_commandLineParser);
         chunkCompiler->setErrorContainer(errors);
@@ -727,8 +742,8 @@ bool Compiler::parseinit_() {
 
         FileContent* const chunkFileContent =
             new FileContent(compiler->getParser()->getFileId(0),
-                            compiler->getParser()->getLibrary(), symbols,
-                            errors, nullptr, ppId);
+                            compiler->getParser()->getLibrary(),
+                            m_symbolTable, errors, nullptr, ppId);
         chunkCompiler->getParser()->setFileContent(chunkFileContent);
         getDesign()->addFileContent(compiler->getParser()->getFileId(0),
                                     chunkFileContent);
@@ -737,11 +752,7 @@ bool Compiler::parseinit_() {
       }
     } else {
       if ((!m_commandLineParser->fileunit()) && m_text.empty()) {
-        SymbolTable* symbols =
-            new SymbolTable(m_commandLineParser->getSymbolTable());
-        m_symbolTables.push_back(symbols);
-        compiler->setSymbolTable(symbols);
-        ErrorContainer* errors = new ErrorContainer(symbols);
+        ErrorContainer* errors = new ErrorContainer(m_symbolTable);
         m_errorContainers.push_back(errors);
         errors->registerCmdLine(m_commandLineParser);
         compiler->setErrorContainer(errors);
@@ -769,7 +780,6 @@ ErrorContainer::Stats Compiler::getErrorStats() const {
 bool Compiler::cleanup_() {
   DeleteContainerPointersAndClear(&m_compilers);
   DeleteContainerPointersAndClear(&m_compilationUnits);
-  DeleteContainerPointersAndClear(&m_symbolTables);
   DeleteContainerPointersAndClear(&m_errorContainers);
   return true;
 }
@@ -834,9 +844,11 @@ bool Compiler::compileFileSet_(CompileSourceFile::Action action,
     // Optimize the load balance, try to even out the work in each thread by the
     // size of the files
     std::vector<std::vector<CompileSourceFile*>> jobArray(maxThreadCount);
+    std::vector<std::vector<size_t>> jobIndexes(maxThreadCount);
     std::vector<unsigned long> jobSize(maxThreadCount, 0);
 
-    for (CompileSourceFile* const source : container) {
+    for (size_t index = 0; index < container.size(); ++index) {
+      CompileSourceFile* const source = container[index];
       const unsigned int size = source->getJobSize(action);
       unsigned int newJobIndex = 0;
       uint64_t minJobQueue = ULLONG_MAX;
@@ -849,6 +861,7 @@ bool Compiler::compileFileSet_(CompileSourceFile::Action action,
 
       jobSize[newJobIndex] += size;
       jobArray[newJobIndex].push_back(source);
+      jobIndexes[newJobIndex].push_back(index);
     }
 
     if (getCommandLineParser()->profile()) {
@@ -875,10 +888,17 @@ bool Compiler::compileFileSet_(CompileSourceFile::Action action,
       }
     }
 
+    // Each file signals its completion, its error container is then no
+    // longer written to by its thread
+    std::vector<bool> completed(container.size(), false);
+    std::mutex completedMutex;
+    std::condition_variable completedCond;
+
     // Create the threads with their respective workloads
     std::vector<std::thread*> threads;
     for (unsigned short i = 0; i < maxThreadCount; i++) {
-      std::thread* th = new std::thread([=] {
+      // By reference: the threads are joined before the end of the scope
+      std::thread* th = new std::thread([&, i] {
         for (unsigned int j = 0; j < jobArray[i].size(); j++) {
 #ifdef SURELOG_WITH_PYTHON
           if (getCommandLineParser()->pythonListener() ||
@@ -894,11 +914,32 @@ bool Compiler::compileFileSet_(CompileSourceFile::Action action,
             jobArray[i][j]->shutdownPythonInterp();
           }
 #endif
+          {
+            std::lock_guard<std::mutex> lock(completedMutex);
+            completed[jobIndexes[i][j]] = true;
+          }
+          completedCond.notify_one();
         }
       });
       threads.push_back(th);
     }
 
+    // Promote report to master error container and print it while the
+    // threads still run: in the file order, as soon as a file and all the
+    // files before it are done. The output does not depend on the
+    // scheduling and each printMessages only formats the new errors.
+    bool fatalErrors = false;
+    for (size_t index = 0; index < container.size(); ++index) {
+      {
+        std::unique_lock<std::mutex> lock(completedMutex);
+        completedCond.wait(lock, [&] { return completed[index]; });
+      }
+      ErrorContainer* const errors = container[index]->getErrorContainer();
+      m_errors->appendErrors(*errors);
+      if (errors->hasFatalErrors()) fatalErrors = true;
+      m_errors->printMessages(m_commandLineParser->muteStdout());
+    }
+
     // Wait for all of them to finish
     for (auto& t : threads) {
       t->join();
@@ -907,23 +948,56 @@ bool Compiler::compileFileSet_(CompileSourceFile::Action action,
     // Delete the threads
     DeleteContainerPointersAndClear(&threads);
 
-    // Promote report to master error container
-    bool fatalErrors = false;
-    for (CompileSourceFile* const source : container) {
-      m_errors->appendErrors(*source->getErrorContainer());
-      if (source->getErrorContainer()->hasFatalErrors()) fatalErrors = true;
-    }
-    m_errors->printMessages(m_commandLineParser->muteStdout());
-
     if (fatalErrors) return false;
   }
   return true;
 }
 
+uint64_t Compiler::processDFACaches_(bool save) {
+  // The prediction DFAs are static members of the generated parsers, any
+  // instance gives access to them.
+  antlr4::ANTLRInputStream input;
+  SV3_1aLexer lexer(&input);
+  antlr4::CommonTokenStream tokens(&lexer);
+  SV3_1aParser parser(&tokens);
+  SV3_1aPpLexer ppLexer(&input);
+  antlr4::CommonTokenStream ppTokens(&ppLexer);
+  SV3_1aPpParser ppParser(&ppTokens);
+
+  const fs::path cacheDir =
+      m_commandLineParser->getSymbolTable().getSymbol(
+          m_commandLineParser->getCacheDir());
+  uint64_t nbStates = 0;
+  for (antlr4::Parser* const recognizer :
+       std::vector<antlr4::Parser*>{&parser, &ppParser}) {
+    DFACache cache(recognizer, cacheDir);
+    if (save) {
+      cache.save();
+    } else {
+      cache.restore();
+      nbStates += cache.getNbRestoredStates();
+    }
+  }
+  return nbStates;
+}
+
 bool Compiler::compile() {
   std::string profile;
   Timer tmr;
   Timer tmrTotal;
+  // Warm up the parsers prediction before any parsing, libraries included
+  if (m_commandLineParser->dfaCache()) {
+    const uint64_t nbStates = processDFACaches_(false);
+    if (m_commandLineParser->profile()) {
+      std::string msg = "DFA cache restore took " +
+                        StringUtils::to_string(tmr.elapsed_rounded()) + "s (" +
+                        std::to_string(nbStates) + " states)\n";
+      std::cout << msg << std::endl;
+      profile += msg;
+      tmr.reset();
+    }
+  }
+
   // Scan the libraries definition
   if (!parseLibrariesDef_()) return false;
 
@@ -978,14 +1052,25 @@ bool Compiler::compile() {
   }
 
   if (m_commandLineParser->profile()) {
-    std::string msg =
-        "Parsing took " + StringUtils::to_string(tmr.elapsed_rounded()) + "s\n";
+    std::string msg = "Parsing took " +
+                      StringUtils::to_string(tmr.elapsed_rounded()) + "s" +
+                      peakMemoryInfo() + "\n";
     for (unsigned int i = 0; i < m_compilersParentFiles.size(); i++) {
       msg += m_compilersParentFiles[i]->getParser()->getProfileInfo();
     }
     for (unsigned int i = 0; i < m_compilers.size(); i++) {
       msg += m_compilers[i]->getParser()->getProfileInfo();
     }
+    if (!m_parserProfiler.empty()) {
+      const fs::path directory = getSymbolTable()->getSymbol(
+          m_commandLineParser->getFullCompileDir());
+      for (const char* name : {"parser_profile.json", "parser_profile.csv"}) {
+        const fs::path fileName = directory / name;
+        if (m_parserProfiler.write(fileName)) {
+          msg += "Grammar profile: " + fileName.string() + "\n";
+        }
+      }
+    }
 
     std::cout << msg << std::endl;
     profile += msg;
@@ -1026,7 +1111,8 @@ bool Compiler::compile() {
 
     if (m_commandLineParser->profile()) {
       std::string msg = "Compilation took " +
-                        StringUtils::to_string(tmr.elapsed_rounded()) + "s\n";
+                        StringUtils::to_string(tmr.elapsed_rounded()) + "s" +
+                        peakMemoryInfo() + "\n";
       std::cout << msg << std::endl;
       profile += msg;
       tmr.reset();
@@ -1038,7 +1124,8 @@ bool Compiler::compile() {
 
       if (m_commandLineParser->profile()) {
         std::string msg = "Elaboration took " +
-                          StringUtils::to_string(tmr.elapsed_rounded()) + "s\n";
+                          StringUtils::to_string(tmr.elapsed_rounded()) + "s" +
+                          peakMemoryInfo() + "\n";
         std::cout << msg << std::endl;
         profile += msg;
         tmr.reset();
@@ -1068,10 +1155,13 @@ bool Compiler::compile() {
     // Do not delete as now UHDM has to live past the compilation step
     // delete compileDesign;
   }
+  if (m_commandLineParser->createDfaCache()) {
+    processDFACaches_(true);
+  }
   if (m_commandLineParser->profile()) {
     std::string msg = "Total time " +
                       StringUtils::to_string(tmrTotal.elapsed_rounded()) +
-                      "s\n";
+                      "s" + peakMemoryInfo() + "\n";
     profile += msg;
     profile = std::string("==============\n") + "PROFILE\n" +
               std::string("==============\n") + profile + "==============\n";
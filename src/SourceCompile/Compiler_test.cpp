@@ -0,0 +1,160 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/CommandLine/CommandLineParser.h>
+#include <Surelog/Design/FileContent.h>
+#include <Surelog/ErrorReporting/ErrorContainer.h>
+#include <Surelog/SourceCompile/CompileSourceFile.h>
+#include <Surelog/SourceCompile/Compiler.h>
+#include <Surelog/SourceCompile/ParseFile.h>
+#include <Surelog/SourceCompile/SymbolTable.h>
+#include <gtest/gtest.h>
+
+// UHDM
+#include <uhdm/vpi_visitor.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr int kNbFiles = 8;
+
+// Files sharing headers and macros, with clocking blocks declared out of
+// alphabetical order and a recursive macro
+std::vector<fs::path> writeDesign(const fs::path& dir) {
+  std::ofstream(dir / "common.svh") << R"(
+`define WIDTH 8
+`define LOOP_A `LOOP_B
+`define LOOP_B `LOOP_A
+)";
+  std::vector<fs::path> files;
+  for (int i = 0; i < kNbFiles; i++) {
+    const std::string n = std::to_string(i);
+    const fs::path header = dir / ("defs" + n + ".svh");
+    std::ofstream(header) << "`define SIZE_" + n + " (`WIDTH + " + n + ")\n";
+    const fs::path file = dir / ("m" + n + ".sv");
+    std::ofstream ofs(file);
+    ofs << "`include \"" << (dir / "common.svh").string() << "\"\n"
+        << "`include \"" << header.string() << "\"\n"
+        << "module m" << n << "(input logic clk, output logic [`SIZE_" << n
+        << "-1:0] q_" << n << ");\n"
+        << "  clocking cb_z" << n << " @(posedge clk); endclocking\n"
+        << "  clocking cb_m" << n << " @(negedge clk); endclocking\n"
+        << "  clocking cb_a" << n << " @(posedge clk); endclocking\n"
+        << "  logic [`SIZE_" << n << "-1:0] r_" << n << ";\n";
+    if (i == kNbFiles - 1) ofs << "  initial r_" << n << " = `LOOP_A;\n";
+    ofs << "  assign q_" << n << " = r_" << n << ";\n"
+        << "endmodule\n";
+    files.push_back(file);
+  }
+  const fs::path top = dir / "top.sv";
+  std::ofstream ofs(top);
+  ofs << "`include \"" << (dir / "common.svh").string() << "\"\n";
+  for (int i = 0; i < kNbFiles; i++) {
+    const fs::path header = dir / ("defs" + std::to_string(i) + ".svh");
+    ofs << "`include \"" << header.string() << "\"\n";
+  }
+  ofs << "module top(input logic clk);\n";
+  for (int i = 0; i < kNbFiles; i++) {
+    const std::string n = std::to_string(i);
+    ofs << "  logic [`SIZE_" << n << "-1:0] q_" << n << ";\n"
+        << "  m" << n << " u" << n << "(.clk(clk), .q_" << n << "(q_" << n
+        << "));\n";
+  }
+  ofs << "endmodule\n";
+  files.push_back(top);
+  return files;
+}
+
+// The parse tree with the names of the symbols and files: the SymbolIds
+// printed by FileContent::printObjects are registered by the threads in
+// scheduling order
+std::string dumpObjects(FileContent* fC) {
+  SymbolTable* const symbols = fC->getSymbolTable();
+  std::string text = "FILE: " + fC->getFileName().string() + "\n";
+  const std::vector<VObject>& objects = fC->getVObjects();
+  for (NodeId id = 0; id < objects.size(); id++) {
+    const VObject& object = objects[id];
+    text += "n<" + symbols->getSymbol(object.m_name) + "> t<" +
+            VObject::getTypeName(object.m_type) + "> p<" +
+            std::to_string(object.m_parent) + "> c<" +
+            std::to_string(object.m_child) + "> s<" +
+            std::to_string(object.m_sibling) + "> f<" +
+            symbols->getSymbol(object.m_fileId) + "> l<" +
+            std::to_string(object.m_line) + ":" +
+            std::to_string(object.m_column) + ">\n";
+  }
+  return text;
+}
+
+// Parse tree, messages and UHDM model of a multi-threaded compilation, one
+// compilation unit per file (the macros of the other files would depend on
+// the scheduling)
+std::string compile(const fs::path& dir, const std::vector<fs::path>& files) {
+  std::vector<std::string> args = {"surelog",   "-mt",      "4",
+                                   "-fileunit", "-nocache", "-parse",
+                                   "-nostdout", "-nouhdm",  "-elabuhdm",
+                                   "-o",        (dir / "out").string()};
+  for (const fs::path& file : files) args.push_back(file.string());
+  std::vector<const char*> argv;
+  for (const std::string& arg : args) argv.push_back(arg.c_str());
+
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  clp.parseCommandLine(argv.size(), argv.data());
+  Compiler compiler(&clp, &errors, &symbols);
+  compiler.compile();
+
+  std::string output;
+  for (CompileSourceFile* csf : compiler.getCompileSourceFiles()) {
+    output += dumpObjects(csf->getParser()->getFileContent());
+  }
+  for (const Error& error : errors.getErrors()) {
+    output += std::get<0>(errors.createErrorMessage(error));
+  }
+  if (compiler.getUhdmDesign()) {
+    output += UHDM::visit_designs({compiler.getUhdmDesign()});
+  }
+  return output;
+}
+
+TEST(CompilerTest, SameOutputAcrossThreadedRuns) {
+  const fs::path dir = fs::temp_directory_path() / "surelog_compiler_test";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  const std::vector<fs::path> files = writeDesign(dir);
+
+  // The SymbolIds registered by the threads change from run to run, the
+  // output does not
+  const std::string first = compile(dir, files);
+  EXPECT_NE(first.find("cb_z0"), std::string::npos);
+  EXPECT_NE(first.find("LOOP_"), std::string::npos);
+  for (int run = 0; run < 3; run++) {
+    EXPECT_EQ(compile(dir, files), first);
+  }
+
+  fs::remove_all(dir);
+}
+}  // namespace
+}  // namespace SURELOG
@@ -0,0 +1,119 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/IncludeFileIndex.h>
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace SURELOG {
+
+void IncludeFileIndex::build(const std::vector<IncludeFileInfo>& infos,
+                             SymbolId defaultFileId) {
+  constexpr unsigned int kNoEnd = std::numeric_limits<unsigned int>::max();
+  m_ranges.clear();
+  m_defaultFileId = defaultFileId;
+
+  // Line interval [start, end) covered by each record
+  struct Interval {
+    unsigned int m_start;
+    unsigned int m_end;
+    unsigned int m_index;
+  };
+  std::vector<Interval> intervals;
+  std::vector<unsigned int> breakpoints;
+  for (unsigned int index = 0; index < infos.size(); index++) {
+    const IncludeFileInfo& info = infos[index];
+    unsigned int end = kNoEnd;
+    if (info.m_type == IncludeFileInfo::PUSH) {
+      if ((info.m_indexClosing < 0) ||
+          (info.m_indexClosing >= (int)infos.size()))
+        continue;
+      end = infos[info.m_indexClosing].m_originalStartLine;
+      if (end <= info.m_originalStartLine) continue;
+      breakpoints.push_back(end);
+    } else if (info.m_type != IncludeFileInfo::POP) {
+      continue;
+    }
+    intervals.push_back({info.m_originalStartLine, end, index});
+    breakpoints.push_back(info.m_originalStartLine);
+  }
+  std::sort(intervals.begin(), intervals.end(),
+            [](const Interval& a, const Interval& b) {
+              return a.m_start < b.m_start;
+            });
+  std::sort(breakpoints.begin(), breakpoints.end());
+  breakpoints.erase(std::unique(breakpoints.begin(), breakpoints.end()),
+                    breakpoints.end());
+
+  // Sweep the breakpoints, the covering record with the highest index wins
+  auto lowerIndex = [&intervals](unsigned int a, unsigned int b) {
+    return intervals[a].m_index < intervals[b].m_index;
+  };
+  std::priority_queue<unsigned int, std::vector<unsigned int>,
+                      decltype(lowerIndex)>
+      active(lowerIndex);
+  unsigned int next = 0;
+  int previous = -2;
+  for (unsigned int line : breakpoints) {
+    while ((next < intervals.size()) && (intervals[next].m_start <= line)) {
+      active.push(next++);
+    }
+    while (!active.empty() && (intervals[active.top()].m_end <= line)) {
+      active.pop();
+    }
+    const int winner =
+        active.empty() ? -1 : static_cast<int>(intervals[active.top()].m_index);
+    if (winner == previous) continue;
+    previous = winner;
+    Range range;
+    range.m_ppStartLine = line;
+    if (winner < 0) {
+      range.m_fileId = defaultFileId;
+      range.m_sectionStartLine = line;
+      range.m_originalStartLine = line;
+    } else {
+      const IncludeFileInfo& info = infos[winner];
+      range.m_fileId = info.m_sectionFile;
+      range.m_sectionStartLine = info.m_sectionStartLine;
+      range.m_originalStartLine = info.m_originalStartLine;
+    }
+    m_ranges.push_back(range);
+  }
+  if (m_ranges.empty()) {
+    // No translation, but mark the index as built
+    Range range;
+    range.m_fileId = defaultFileId;
+    m_ranges.push_back(range);
+  }
+}
+
+std::pair<SymbolId, unsigned int> IncludeFileIndex::translate(
+    unsigned int ppLine) const {
+  if (ppLine == 0) return std::make_pair(m_defaultFileId, 1);
+  auto itr = std::upper_bound(m_ranges.begin(), m_ranges.end(), ppLine,
+                              [](unsigned int line, const Range& range) {
+                                return line < range.m_ppStartLine;
+                              });
+  if (itr == m_ranges.begin()) return std::make_pair(m_defaultFileId, ppLine);
+  --itr;
+  return std::make_pair(
+      itr->m_fileId,
+      itr->m_sectionStartLine + (ppLine - itr->m_originalStartLine));
+}
+
+}  // namespace SURELOG
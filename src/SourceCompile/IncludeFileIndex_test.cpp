@@ -0,0 +1,176 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/IncludeFileIndex.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+constexpr SymbolId kMainFile = 1;
+
+// The reverse linear scan ParseFile::buildLineInfoCache_ did for each line
+// before the index
+std::pair<SymbolId, unsigned int> scan(const std::vector<IncludeFileInfo>& infos,
+                                       unsigned int line) {
+  if (line == 0) return std::make_pair(kMainFile, 1);
+  for (unsigned int index = infos.size(); index-- > 0;) {
+    const IncludeFileInfo& info = infos[index];
+    if (line < info.m_originalStartLine) continue;
+    if ((info.m_type == IncludeFileInfo::POP) ||
+        ((info.m_type == IncludeFileInfo::PUSH) &&
+         (info.m_indexClosing > -1) &&
+         (line < infos[info.m_indexClosing].m_originalStartLine))) {
+      return std::make_pair(
+          info.m_sectionFile,
+          info.m_sectionStartLine + (line - info.m_originalStartLine));
+    }
+  }
+  return std::make_pair(kMainFile, line);
+}
+
+void expectSameAsScan(const std::vector<IncludeFileInfo>& infos,
+                      unsigned int lastLine) {
+  IncludeFileIndex index;
+  index.build(infos, kMainFile);
+  ASSERT_FALSE(index.empty());
+  for (unsigned int line = 0; line <= lastLine + 10; line++) {
+    ASSERT_EQ(index.translate(line), scan(infos, line)) << "line " << line;
+  }
+}
+
+// The records of a preprocessor output, see PreprocessFile: a PUSH where an
+// included file starts, a POP where the includer resumes, linked together
+class IncludeRecorder {
+ public:
+  IncludeRecorder() { m_stack.push_back({kMainFile, 1, -1}); }
+
+  // Lines of the current file
+  void lines(unsigned int count) {
+    for (unsigned int i = 0; i < count; i++) {
+      m_truth.emplace_back(m_stack.back().m_fileId, m_stack.back().m_line++);
+    }
+  }
+
+  void push(SymbolId fileId) {
+    m_stack.back().m_line++;  // The `include line
+    m_stack.push_back({fileId, 1, static_cast<int>(m_infos.size())});
+    m_infos.emplace_back(1, fileId, ppLine(), 0, 0, 0, IncludeFileInfo::PUSH);
+  }
+
+  void pop() {
+    const int opening = m_stack.back().m_opening;
+    m_stack.pop_back();
+    m_infos[opening].m_indexClosing = m_infos.size();
+    m_infos.emplace_back(m_stack.back().m_line, m_stack.back().m_fileId,
+                         ppLine(), 0, 0, 0, IncludeFileInfo::POP, opening, -1);
+  }
+
+  size_t depth() const { return m_stack.size() - 1; }
+  unsigned int ppLine() const { return m_truth.size() + 1; }
+  const std::vector<IncludeFileInfo>& infos() const { return m_infos; }
+  // (file, line) of each line of the output, from line 1
+  const std::vector<std::pair<SymbolId, unsigned int>>& truth() const {
+    return m_truth;
+  }
+
+ private:
+  struct Open {
+    SymbolId m_fileId;
+    unsigned int m_line;
+    int m_opening;
+  };
+  std::vector<Open> m_stack;
+  std::vector<IncludeFileInfo> m_infos;
+  std::vector<std::pair<SymbolId, unsigned int>> m_truth;
+};
+
+TEST(IncludeFileIndexTest, NestedIncludes) {
+  // main includes a.svh, which includes b.svh twice, then c.svh
+  IncludeRecorder recorder;
+  recorder.lines(3);
+  recorder.push(2);
+  recorder.lines(2);
+  recorder.push(3);
+  recorder.lines(4);
+  recorder.pop();
+  recorder.lines(1);
+  recorder.push(3);
+  recorder.lines(4);
+  recorder.pop();
+  recorder.pop();
+  recorder.lines(2);
+  recorder.push(4);
+  recorder.push(5);  // Empty include
+  recorder.pop();
+  recorder.lines(3);
+  recorder.pop();
+  recorder.lines(5);
+
+  const std::vector<IncludeFileInfo>& infos = recorder.infos();
+  IncludeFileIndex index;
+  index.build(infos, kMainFile);
+  for (unsigned int line = 1; line < recorder.ppLine(); line++) {
+    EXPECT_EQ(index.translate(line), recorder.truth()[line - 1])
+        << "line " << line;
+  }
+  EXPECT_EQ(index.translate(0), std::make_pair(kMainFile, 1u));
+  expectSameAsScan(infos, recorder.ppLine());
+}
+
+TEST(IncludeFileIndexTest, UnclosedAndEmpty) {
+  // No record, then an include whose POP is missing
+  expectSameAsScan({}, 20);
+  std::vector<IncludeFileInfo> infos;
+  infos.emplace_back(1, 2, 5, 0, 0, 0, IncludeFileInfo::PUSH);
+  expectSameAsScan(infos, 20);
+  infos.emplace_back(1, 3, 8, 0, 0, 0, IncludeFileInfo::PUSH, -1, 2);
+  infos.emplace_back(2, 2, 8, 0, 0, 0, IncludeFileInfo::POP, 1, -1);
+  expectSameAsScan(infos, 20);
+}
+
+TEST(IncludeFileIndexTest, RandomNesting) {
+  std::mt19937 rng(28);
+  for (int round = 0; round < 200; round++) {
+    IncludeRecorder recorder;
+    const int steps = 1 + rng() % 60;
+    for (int step = 0; step < steps; step++) {
+      switch (rng() % 4) {
+        case 0:
+          if (recorder.depth() < 6) recorder.push(2 + rng() % 5);
+          break;
+        case 1:
+          if (recorder.depth() > 0) recorder.pop();
+          break;
+        default:
+          recorder.lines(rng() % 4);
+          break;
+      }
+    }
+    // Some sections are left open, as in a file ending inside an include
+    if (rng() % 2) {
+      while (recorder.depth() > 0) recorder.pop();
+    }
+    expectSameAsScan(recorder.infos(), recorder.ppLine());
+    if (HasFatalFailure()) return;
+  }
+}
+}  // namespace
+}  // namespace SURELOG
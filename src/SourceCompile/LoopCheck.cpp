@@ -23,75 +23,137 @@
 
 #include <Surelog/SourceCompile/LoopCheck.h>
 
-#include <queue>
+#include <algorithm>
 
 namespace SURELOG {
 
-LoopCheck::~LoopCheck() {
-  for (auto itr : m_nodes) {
-    delete itr.second;
-  }
-}
-
 void LoopCheck::clear() {
-  for (auto itr : m_nodes) {
-    delete itr.second;
-  }
   m_nodes.clear();
+  m_index.clear();
+  m_edges.clear();
+  m_loop.clear();
+  m_firstOrder = 0;
+  m_lastOrder = -1;
+  m_cyclic = false;
+}
+
+unsigned int LoopCheck::node_(SymbolId objId, bool& created) {
+  auto [it, inserted] = m_index.emplace(objId, m_nodes.size());
+  if (inserted) m_nodes.emplace_back(objId, ++m_lastOrder);
+  created = inserted;
+  return it->second;
 }
 
 bool LoopCheck::addEdge(SymbolId from, SymbolId to) {
   // Create Graph
-  std::map<SymbolId, Node*>::iterator fromIt = m_nodes.find(from);
-  std::map<SymbolId, Node*>::iterator toIt = m_nodes.find(to);
-  Node* nodeFrom = nullptr;
-  Node* nodeTo = nullptr;
-  if (fromIt == m_nodes.end()) {
-    nodeFrom = new Node(from);
-    m_nodes.insert(std::make_pair(from, nodeFrom));
-  } else {
-    nodeFrom = (*fromIt).second;
+  bool newFrom = false;
+  bool newTo = false;
+  const unsigned int x = node_(from, newFrom);
+  const unsigned int y = node_(to, newTo);
+  // A new node has no edge yet: a new caller can go first in the order
+  // (callees registered before their callers), a new callee last
+  if (newFrom && (x != y)) m_nodes[x].m_order = --m_firstOrder;
+  m_loop.clear();
+  if (m_edges.insert((static_cast<uint64_t>(x) << 32) | y).second) {
+    m_nodes[x].m_toList.push_back(y);
+    m_nodes[y].m_fromList.push_back(x);
   }
-  if (toIt == m_nodes.end()) {
-    nodeTo = new Node(to);
-    m_nodes.insert(std::make_pair(to, nodeTo));
-  } else {
-    nodeTo = (*toIt).second;
+  if (x == y) {
+    m_loop.push_back(from);
+    m_cyclic = true;
+    return true;
   }
-  nodeFrom->m_toList.insert(nodeTo);
 
-  for (auto& itr : m_nodes) {
-    itr.second->m_visited = false;
+  std::vector<unsigned int> forward;
+  if (m_cyclic) return searchForward_(x, y, false, forward);
+  // The edge agrees with the order
+  if (m_nodes[x].m_order < m_nodes[y].m_order) return false;
+
+  // The nodes reachable from "to" and ordered before "from": reaching
+  // "from" closes a loop
+  if (searchForward_(x, y, true, forward)) {
+    m_cyclic = true;
+    return true;
   }
+  // The nodes reaching "from" and ordered after "to"
+  std::vector<unsigned int> backward;
+  searchBackward_(x, m_nodes[y].m_order, backward);
+  reorder_(forward, backward);
+  return false;
+}
 
-  // BFS
-  std::queue<Node*> queue;
-  queue.push(nodeTo);
-  nodeTo->m_visited = true;
-  while (!queue.empty()) {
-    Node* tmp = queue.front();
-    queue.pop();
-    tmp->m_visited = true;
-    for (auto next : tmp->m_toList) {
-      if (next->m_visited)
+bool LoopCheck::searchForward_(unsigned int from, unsigned int to,
+                               bool bounded,
+                               std::vector<unsigned int>& reached) {
+  const unsigned int search = ++m_search;
+  const int64_t upperBound = m_nodes[from].m_order;
+  std::vector<unsigned int> stack(1, to);
+  m_nodes[to].m_visited = search;
+  while (!stack.empty()) {
+    const unsigned int current = stack.back();
+    stack.pop_back();
+    reached.push_back(current);
+    for (const unsigned int next : m_nodes[current].m_toList) {
+      Node& node = m_nodes[next];
+      if (node.m_visited == search) continue;
+      if (next == from) {
+        // The loop: to -> ... -> current -> from -> to
+        node.m_parent = current;
+        for (unsigned int n = from;; n = m_nodes[n].m_parent) {
+          m_loop.push_back(m_nodes[n].m_objId);
+          if (n == to) break;
+        }
+        std::sort(m_loop.begin(), m_loop.end());
         return true;
-      else {
-        queue.push(next);
       }
+      if (bounded && (node.m_order > upperBound)) continue;
+      node.m_visited = search;
+      node.m_parent = current;
+      stack.push_back(next);
     }
   }
-
   return false;
 }
 
-std::vector<SymbolId> LoopCheck::reportLoop() const {
-  std::vector<SymbolId> loop;
-  for (const auto& itr : m_nodes) {
-    if (itr.second->m_visited) {
-      loop.push_back(itr.first);
+void LoopCheck::searchBackward_(unsigned int from, int64_t lowerBound,
+                                std::vector<unsigned int>& reached) {
+  const unsigned int search = ++m_search;
+  std::vector<unsigned int> stack(1, from);
+  m_nodes[from].m_visited = search;
+  while (!stack.empty()) {
+    const unsigned int current = stack.back();
+    stack.pop_back();
+    reached.push_back(current);
+    for (const unsigned int previous : m_nodes[current].m_fromList) {
+      Node& node = m_nodes[previous];
+      if ((node.m_visited == search) || (node.m_order <= lowerBound)) {
+        continue;
+      }
+      node.m_visited = search;
+      stack.push_back(previous);
     }
   }
-  return loop;
 }
 
+void LoopCheck::reorder_(std::vector<unsigned int>& forward,
+                         std::vector<unsigned int>& backward) {
+  // The nodes reaching "from" go first, then the ones reachable from "to",
+  // in the positions they already occupied
+  auto byOrder = [this](unsigned int lhs, unsigned int rhs) {
+    return m_nodes[lhs].m_order < m_nodes[rhs].m_order;
+  };
+  std::sort(forward.begin(), forward.end(), byOrder);
+  std::sort(backward.begin(), backward.end(), byOrder);
+  std::vector<int64_t> orders;
+  orders.reserve(forward.size() + backward.size());
+  for (const unsigned int n : backward) orders.push_back(m_nodes[n].m_order);
+  for (const unsigned int n : forward) orders.push_back(m_nodes[n].m_order);
+  std::sort(orders.begin(), orders.end());
+  size_t i = 0;
+  for (const unsigned int n : backward) m_nodes[n].m_order = orders[i++];
+  for (const unsigned int n : forward) m_nodes[n].m_order = orders[i++];
+}
+
+std::vector<SymbolId> LoopCheck::reportLoop() const { return m_loop; }
+
 }  // namespace SURELOG
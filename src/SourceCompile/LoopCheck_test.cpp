@@ -0,0 +1,133 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/LoopCheck.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+namespace SURELOG {
+using ::testing::ElementsAre;
+
+namespace {
+TEST(LoopCheckTest, ReportsTheLoop) {
+  LoopCheck check;
+  EXPECT_FALSE(check.addEdge(1, 4));
+  EXPECT_FALSE(check.addEdge(4, 6));
+  EXPECT_FALSE(check.addEdge(6, 5));
+  EXPECT_FALSE(check.addEdge(4, 5));  // Not a loop, two paths to 5
+  EXPECT_FALSE(check.addEdge(4, 5));
+  EXPECT_TRUE(check.addEdge(5, 4));
+  EXPECT_THAT(check.reportLoop(), ElementsAre(4, 5));
+
+  check.clear();
+  EXPECT_TRUE(check.addEdge(3, 3));
+  EXPECT_THAT(check.reportLoop(), ElementsAre(3));
+
+  check.clear();
+  EXPECT_FALSE(check.addEdge(7, 8));
+  EXPECT_FALSE(check.addEdge(8, 2));
+  EXPECT_TRUE(check.addEdge(2, 7));
+  EXPECT_THAT(check.reportLoop(), ElementsAre(2, 7, 8));
+}
+
+TEST(LoopCheckTest, DiamondIsNotALoop) {
+  LoopCheck check;
+  EXPECT_FALSE(check.addEdge(1, 2));
+  EXPECT_FALSE(check.addEdge(1, 3));
+  EXPECT_FALSE(check.addEdge(3, 2));
+  // 2 is reached from 1 directly and through 3
+  EXPECT_FALSE(check.addEdge(4, 1));
+  EXPECT_FALSE(check.addEdge(4, 2));
+  EXPECT_TRUE(check.addEdge(2, 4));
+  EXPECT_THAT(check.reportLoop(), ElementsAre(2, 4));
+}
+
+// A new edge closes a loop when its source is reachable from its target
+bool reaches(const std::vector<std::set<SymbolId>>& edges, SymbolId from,
+             SymbolId to) {
+  std::vector<bool> visited(edges.size(), false);
+  std::vector<SymbolId> stack(1, from);
+  while (!stack.empty()) {
+    const SymbolId current = stack.back();
+    stack.pop_back();
+    if (current == to) return true;
+    if (visited[current]) continue;
+    visited[current] = true;
+    for (SymbolId next : edges[current]) stack.push_back(next);
+  }
+  return false;
+}
+
+TEST(LoopCheckTest, MatchesReachability) {
+  std::mt19937 random(42);
+  for (int graph = 0; graph < 200; ++graph) {
+    constexpr SymbolId kNodes = 30;
+    std::uniform_int_distribution<SymbolId> pick(0, kNodes - 1);
+    LoopCheck check;
+    std::vector<std::set<SymbolId>> edges(kNodes);
+    for (int i = 0; i < 60; ++i) {
+      const SymbolId from = pick(random);
+      const SymbolId to = pick(random);
+      const bool loop = reaches(edges, to, from);
+      edges[from].insert(to);
+      ASSERT_EQ(check.addEdge(from, to), loop);
+      if (!loop) continue;
+      // Every reported node is on a loop through the new edge
+      for (SymbolId id : check.reportLoop()) {
+        EXPECT_TRUE(reaches(edges, to, id) && reaches(edges, id, from));
+      }
+      break;
+    }
+  }
+}
+
+// Deep chains of macro calls, registered caller first and callee first,
+// and a wide fan-out/fan-in macro graph. Each edge only visits the nodes
+// between its two ends in the order: these run in linear time.
+TEST(LoopCheckTest, DeepAndWideGraphs) {
+  constexpr SymbolId kDepth = 100000;
+  constexpr SymbolId kWidth = 100000;
+
+  LoopCheck deep;
+  for (SymbolId i = 1; i <= kDepth; ++i) {
+    ASSERT_FALSE(deep.addEdge(i, i + 1));
+  }
+  EXPECT_TRUE(deep.addEdge(kDepth + 1, 1));
+  EXPECT_EQ(deep.reportLoop().size(), kDepth + 1);
+
+  LoopCheck reversed;
+  for (SymbolId i = kDepth; i > 0; --i) {
+    ASSERT_FALSE(reversed.addEdge(i, i + 1));
+  }
+  EXPECT_TRUE(reversed.addEdge(kDepth + 1, 1));
+  EXPECT_EQ(reversed.reportLoop().size(), kDepth + 1);
+
+  LoopCheck wide;
+  const SymbolId root = 1;
+  const SymbolId sink = 2;
+  for (SymbolId i = 0; i < kWidth; ++i) {
+    ASSERT_FALSE(wide.addEdge(100 + i, sink));
+    ASSERT_FALSE(wide.addEdge(root, 100 + i));
+  }
+  EXPECT_TRUE(wide.addEdge(sink, root));
+  EXPECT_EQ(wide.reportLoop().size(), 3);
+}
+}  // namespace
+}  // namespace SURELOG
@@ -22,3 +22,63 @@
  */
 
 #include <Surelog/SourceCompile/MacroInfo.h>
+
+namespace SURELOG {
+
+namespace {
+template <typename Strings>
+size_t totalSize(const Strings& strings) {
+  size_t size = 0;
+  for (const auto& s : strings) size += s.size();
+  return size;
+}
+
+template <typename Strings>
+std::string concatenate(const Strings& arguments, const Strings& tokens) {
+  std::string text;
+  text.reserve(totalSize(arguments) + totalSize(tokens));
+  for (const auto& s : arguments) text.append(s);
+  for (const auto& s : tokens) text.append(s);
+  return text;
+}
+
+template <typename Strings>
+std::vector<std::string_view> slice(std::string_view text, size_t offset,
+                                    const Strings& strings) {
+  std::vector<std::string_view> result;
+  result.reserve(strings.size());
+  for (const auto& s : strings) {
+    result.emplace_back(text.substr(offset, s.size()));
+    offset += s.size();
+  }
+  return result;
+}
+}  // namespace
+
+MacroInfo::MacroInfo(std::string_view name, int type, SymbolId file,
+                     unsigned int line, unsigned short int column,
+                     const std::vector<std::string>& arguments,
+                     const std::vector<std::string>& tokens)
+    : m_name(name),
+      m_type(type),
+      m_file(file),
+      m_line(line),
+      m_column(column),
+      m_text(concatenate(arguments, tokens)),
+      m_arguments(slice(m_text, 0, arguments)),
+      m_tokens(slice(m_text, totalSize(arguments), tokens)) {}
+
+MacroInfo::MacroInfo(std::string_view name, int type, SymbolId file,
+                     unsigned int line, unsigned short int column,
+                     const std::vector<std::string_view>& arguments,
+                     const std::vector<std::string_view>& tokens)
+    : m_name(name),
+      m_type(type),
+      m_file(file),
+      m_line(line),
+      m_column(column),
+      m_text(concatenate(arguments, tokens)),
+      m_arguments(slice(m_text, 0, arguments)),
+      m_tokens(slice(m_text, totalSize(arguments), tokens)) {}
+
+}  // namespace SURELOG
@@ -0,0 +1,90 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/MacroStorage.h>
+
+namespace SURELOG {
+
+size_t MacroStorage::findSlot_(SymbolId id) const {
+  const size_t mask = m_slots.size() - 1;
+  // Fibonacci hashing, ids are small consecutive integers
+  size_t slot = (size_t)((id * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+  while (true) {
+    const uint32_t index = m_slots[slot];
+    if ((index == kEmptySlot) || (m_entries[index - 1].m_id == id)) {
+      return slot;
+    }
+    slot = (slot + 1) & mask;
+  }
+}
+
+void MacroStorage::rehash_() {
+  // Erased entries are dropped here, they only linger until the next growth
+  std::vector<Entry> live;
+  live.reserve(m_size);
+  for (const Entry& entry : m_entries) {
+    if (entry.m_macro) live.push_back(entry);
+  }
+  m_entries.swap(live);
+
+  size_t capacity = 16;
+  while (capacity * 3 < (m_size + 1) * 8) capacity *= 2;
+  m_slots.assign(capacity, kEmptySlot);
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    m_slots[findSlot_(m_entries[i].m_id)] = i + 1;
+  }
+}
+
+MacroInfo* MacroStorage::find(SymbolId id) const {
+  if (m_slots.empty()) return nullptr;
+  const uint32_t index = m_slots[findSlot_(id)];
+  if (index == kEmptySlot) return nullptr;
+  return m_entries[index - 1].m_macro;
+}
+
+bool MacroStorage::insert(SymbolId id, MacroInfo* macro) {
+  if ((m_entries.size() + 1) * 4 > m_slots.size() * 3) rehash_();
+  const size_t slot = findSlot_(id);
+  const uint32_t index = m_slots[slot];
+  if ((index != kEmptySlot) && m_entries[index - 1].m_macro) return false;
+  // A slot pointing to an erased entry is simply redirected
+  m_entries.push_back({id, macro});
+  m_slots[slot] = m_entries.size();
+  m_size++;
+  return true;
+}
+
+MacroInfo* MacroStorage::erase(SymbolId id) {
+  if (m_slots.empty()) return nullptr;
+  const uint32_t index = m_slots[findSlot_(id)];
+  if (index == kEmptySlot) return nullptr;
+  Entry& entry = m_entries[index - 1];
+  MacroInfo* macro = entry.m_macro;
+  if (macro) {
+    // The slot is kept, it acts as a tombstone for the probe sequence
+    entry.m_macro = nullptr;
+    m_size--;
+  }
+  return macro;
+}
+
+void MacroStorage::clear() {
+  m_slots.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+}  // namespace SURELOG
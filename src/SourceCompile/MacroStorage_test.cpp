@@ -0,0 +1,107 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/MacroInfo.h>
+#include <Surelog/SourceCompile/MacroStorage.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+std::unique_ptr<MacroInfo> makeMacro(std::string_view name) {
+  return std::make_unique<MacroInfo>(name, MacroInfo::NO_ARGS, 1, 1, 0,
+                                     std::vector<std::string>(),
+                                     std::vector<std::string>());
+}
+
+TEST(MacroStorageTest, InsertFindErase) {
+  MacroStorage storage;
+  auto foo = makeMacro("FOO");
+  auto bar = makeMacro("BAR");
+  EXPECT_TRUE(storage.empty());
+  EXPECT_EQ(storage.find(1), nullptr);
+  EXPECT_EQ(storage.erase(1), nullptr);
+
+  EXPECT_TRUE(storage.insert(1, foo.get()));
+  EXPECT_TRUE(storage.insert(2, bar.get()));
+  EXPECT_EQ(storage.size(), size_t(2));
+  EXPECT_EQ(storage.find(1), foo.get());
+  EXPECT_EQ(storage.find(2), bar.get());
+  EXPECT_EQ(storage.find(3), nullptr);
+
+  // First definition wins
+  EXPECT_FALSE(storage.insert(1, bar.get()));
+  EXPECT_EQ(storage.find(1), foo.get());
+
+  EXPECT_EQ(storage.erase(1), foo.get());
+  EXPECT_EQ(storage.find(1), nullptr);
+  EXPECT_EQ(storage.erase(1), nullptr);
+  EXPECT_EQ(storage.size(), size_t(1));
+
+  // Redefinition after erase
+  EXPECT_TRUE(storage.insert(1, bar.get()));
+  EXPECT_EQ(storage.find(1), bar.get());
+
+  storage.clear();
+  EXPECT_TRUE(storage.empty());
+  EXPECT_EQ(storage.find(2), nullptr);
+}
+
+TEST(MacroStorageTest, IterationInDefinitionOrder) {
+  std::vector<std::unique_ptr<MacroInfo>> macros;
+  MacroStorage storage;
+  for (SymbolId id = 1000; id > 0; id--) {
+    macros.push_back(makeMacro(std::to_string(id)));
+    EXPECT_TRUE(storage.insert(id, macros.back().get()));
+  }
+  for (SymbolId id = 1; id <= 1000; id += 2) storage.erase(id);
+  EXPECT_EQ(storage.size(), size_t(500));
+
+  SymbolId expected = 1000;
+  for (auto it = storage.begin(); it != storage.end(); ++it) {
+    EXPECT_EQ(it.id(), expected);
+    EXPECT_EQ((*it)->m_name, std::to_string(expected));
+    expected -= 2;
+  }
+  EXPECT_EQ(expected, SymbolId(0));
+  for (SymbolId id = 1; id <= 1000; id++) {
+    EXPECT_EQ(storage.find(id) != nullptr, (id % 2) == 0);
+  }
+}
+
+TEST(MacroStorageTest, MacroTokensShareOneBuffer) {
+  const std::vector<std::string> args = {"a", "b=1"};
+  const std::vector<std::string> tokens = {"(", "a", ")", "+", "b"};
+  MacroInfo info("FOO", MacroInfo::WITH_ARGS, 1, 2, 3, args, tokens);
+  ASSERT_EQ(info.m_arguments.size(), args.size());
+  ASSERT_EQ(info.m_tokens.size(), tokens.size());
+  for (size_t i = 0; i < args.size(); i++) {
+    EXPECT_EQ(info.m_arguments[i], args[i]);
+  }
+  for (size_t i = 0; i < tokens.size(); i++) {
+    EXPECT_EQ(info.m_tokens[i], tokens[i]);
+  }
+  // Contiguous storage: each token starts where the previous one ended
+  EXPECT_EQ(info.m_arguments.back().data() + info.m_arguments.back().size(),
+            info.m_tokens.front().data());
+}
+}  // namespace
+}  // namespace SURELOG
@@ -0,0 +1,96 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/PPOutputBuffer.h>
+
+#include <algorithm>
+
+namespace SURELOG {
+
+void PPOutputBuffer::append(std::string_view text) {
+  if (text.empty()) return;
+  // Extend the last piece when it ends where the new text will start
+  if (!m_pieces.empty() && (m_pieces.back().m_buffer == nullptr) &&
+      (m_pieces.back().m_offset + m_pieces.back().m_length == m_text.size())) {
+    m_pieces.back().m_length += text.size();
+  } else {
+    Piece piece;
+    piece.m_offset = m_text.size();
+    piece.m_length = text.size();
+    m_pieces.push_back(piece);
+  }
+  m_text.append(text);
+  m_size += text.size();
+  m_lineCount += std::count(text.begin(), text.end(), '\n');
+}
+
+void PPOutputBuffer::append(const PPOutputBuffer* buffer) {
+  if ((buffer == nullptr) || buffer->empty()) return;
+  Piece piece;
+  piece.m_length = buffer->size();
+  piece.m_buffer = buffer;
+  m_pieces.push_back(piece);
+  m_size += buffer->size();
+  m_lineCount += buffer->lineCount();
+}
+
+void PPOutputBuffer::clear() {
+  m_pieces.clear();
+  m_text.clear();
+  m_size = 0;
+  m_lineCount = 0;
+}
+
+bool PPOutputBuffer::isBlank() const {
+  for (const Piece& piece : m_pieces) {
+    if (piece.m_buffer) {
+      if (!piece.m_buffer->isBlank()) return false;
+      continue;
+    }
+    std::string_view text(m_text.data() + piece.m_offset, piece.m_length);
+    if (text.find_first_not_of(" \n") != std::string_view::npos) return false;
+  }
+  return true;
+}
+
+void PPOutputBuffer::appendTo(std::string& result) const {
+  for (const Piece& piece : m_pieces) {
+    if (piece.m_buffer) {
+      piece.m_buffer->appendTo(result);
+    } else {
+      result.append(m_text, piece.m_offset, piece.m_length);
+    }
+  }
+}
+
+std::string PPOutputBuffer::str() const {
+  std::string result;
+  result.reserve(m_size);
+  appendTo(result);
+  return result;
+}
+
+void PPOutputBuffer::write(std::ostream& stream) const {
+  for (const Piece& piece : m_pieces) {
+    if (piece.m_buffer) {
+      piece.m_buffer->write(stream);
+    } else {
+      stream.write(m_text.data() + piece.m_offset, piece.m_length);
+    }
+  }
+}
+
+}  // namespace SURELOG
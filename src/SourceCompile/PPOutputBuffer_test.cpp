@@ -0,0 +1,74 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/PPOutputBuffer.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace SURELOG {
+
+namespace {
+TEST(PPOutputBufferTest, AppendText) {
+  PPOutputBuffer buffer;
+  EXPECT_TRUE(buffer.empty());
+  buffer.append("module top;\n");
+  buffer.append("");
+  buffer.append("endmodule\n");
+  EXPECT_EQ(buffer.size(), size_t(22));
+  EXPECT_EQ(buffer.lineCount(), size_t(2));
+  EXPECT_EQ(buffer.str(), "module top;\nendmodule\n");
+}
+
+TEST(PPOutputBufferTest, ReferenceIncludedBuffers) {
+  PPOutputBuffer leaf;
+  leaf.append("`define A\n");
+  PPOutputBuffer child;
+  child.append("// child\n");
+  child.append(&leaf);
+  PPOutputBuffer top;
+  top.append("`line 1 \"child.svh\" 1\n");
+  top.append(&child);
+  top.append("\n`line 2 \"top.sv\" 2\n");
+  top.append(&leaf);
+
+  const std::string expected =
+      "`line 1 \"child.svh\" 1\n// child\n`define A\n"
+      "\n`line 2 \"top.sv\" 2\n`define A\n";
+  EXPECT_EQ(top.str(), expected);
+  EXPECT_EQ(top.size(), expected.size());
+  EXPECT_EQ(top.lineCount(), size_t(6));
+
+  std::ostringstream out;
+  top.write(out);
+  EXPECT_EQ(out.str(), expected);
+}
+
+TEST(PPOutputBufferTest, Blank) {
+  PPOutputBuffer child;
+  child.append("  \n\n ");
+  PPOutputBuffer top;
+  top.append("\n");
+  top.append(&child);
+  EXPECT_TRUE(top.isBlank());
+  top.append("x");
+  EXPECT_FALSE(top.isBlank());
+  top.clear();
+  EXPECT_TRUE(top.empty());
+  EXPECT_EQ(top.str(), "");
+}
+}  // namespace
+}  // namespace SURELOG
@@ -28,8 +28,12 @@
 #include <Surelog/Package/Precompiled.h>
 #include <Surelog/SourceCompile/AntlrParserErrorListener.h>
 #include <Surelog/SourceCompile/AntlrParserHandler.h>
+#include <Surelog/SourceCompile/ByteCharStream.h>
 #include <Surelog/SourceCompile/CompileSourceFile.h>
+#include <Surelog/SourceCompile/Compiler.h>
 #include <Surelog/SourceCompile/ParseFile.h>
+#include <Surelog/SourceCompile/SV3_1aFastLexer.h>
+#include <Surelog/SourceCompile/SV3_1aStreamingListener.h>
 #include <Surelog/SourceCompile/SV3_1aTreeShapeListener.h>
 #include <Surelog/SourceCompile/SymbolTable.h>
 #include <Surelog/Utils/FileUtils.h>
@@ -39,13 +43,35 @@
 #include <parser/SV3_1aLexer.h>
 #include <parser/SV3_1aParser.h>
 
+#include <algorithm>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <memory>
+#include <thread>
 
 namespace SURELOG {
 
 namespace fs = std::filesystem;
 
+namespace {
+// Same as antlr4::BailErrorStrategy, but remembers the innermost rule context
+// at the point of failure so the parse can be resumed locally.
+class SLLBailErrorStrategy : public antlr4::BailErrorStrategy {
+ public:
+  void recover(antlr4::Parser* recognizer, std::exception_ptr e) override {
+    m_failedContext = recognizer->getContext();
+    antlr4::BailErrorStrategy::recover(recognizer, e);
+  }
+
+  antlr4::Token* recoverInline(antlr4::Parser* recognizer) override {
+    m_failedContext = recognizer->getContext();
+    return antlr4::BailErrorStrategy::recoverInline(recognizer);
+  }
+
+  antlr4::ParserRuleContext* m_failedContext = nullptr;
+};
+}  // namespace
+
 ParseFile::ParseFile(SymbolId fileId, SymbolTable* symbolTable,
                      ErrorContainer* errors)
     : m_fileId(fileId),
@@ -135,6 +161,14 @@ ParseFile::~ParseFile() {
   delete m_listener;
 }
 
+void ParseFile::releaseParserHandler() {
+  delete m_antlrParserHandler;
+  m_antlrParserHandler = nullptr;
+  delete m_listener;
+  m_listener = nullptr;
+  for (ParseFile* child : m_children) child->releaseParserHandler();
+}
+
 SymbolTable* ParseFile::getSymbolTable() {
   return m_symbolTable ? m_symbolTable : m_compileSourceFile->getSymbolTable();
 }
@@ -166,56 +200,7 @@ void ParseFile::addError(Error& error) {
 void ParseFile::buildLineInfoCache_() {
   PreprocessFile* pp = getCompileSourceFile()->getPreprocessor();
   if (!pp) return;
-  auto const& infos = pp->getIncludeFileInfo();
-  if (!infos.empty()) {
-    fileInfoCache.resize(pp->getSumLineCount() + 10);
-    lineInfoCache.resize(pp->getSumLineCount() + 10);
-    lineInfoCache[0] = 1;
-    fileInfoCache[0] = m_fileId;
-    for (unsigned int lineItr = 1; lineItr < pp->getSumLineCount() + 10;
-         lineItr++) {
-      fileInfoCache[lineItr] = m_fileId;
-      lineInfoCache[lineItr] = lineItr;
-      bool inRange = false;
-      unsigned int indexOpeningRange = 0;
-      unsigned int index = infos.size() - 1;
-      while (1) {
-        if ((lineItr >= infos[index].m_originalStartLine) &&
-            (infos[index].m_type == IncludeFileInfo::POP)) {
-          SymbolId fileId = infos[index].m_sectionFile;
-          fileInfoCache[lineItr] = fileId;
-          unsigned int l = infos[index].m_sectionStartLine +
-                           (lineItr - infos[index].m_originalStartLine);
-          lineInfoCache[lineItr] = l;
-          break;
-        }
-        if (infos[index].m_type == IncludeFileInfo::POP) {
-          if (!inRange) {
-            inRange = true;
-            indexOpeningRange = infos[index].m_indexOpening;
-          }
-        } else {
-          if (inRange) {
-            if (index == indexOpeningRange) inRange = false;
-          }
-        }
-        if ((lineItr >= infos[index].m_originalStartLine) &&
-            (infos[index].m_type == IncludeFileInfo::PUSH) &&
-            (infos[index].m_indexClosing > -1) &&
-            (lineItr <
-             infos[infos[index].m_indexClosing].m_originalStartLine)) {
-          SymbolId fileId = infos[index].m_sectionFile;
-          fileInfoCache[lineItr] = fileId;
-          unsigned int l = infos[index].m_sectionStartLine +
-                           (lineItr - infos[index].m_originalStartLine);
-          lineInfoCache[lineItr] = l;
-          break;
-        }
-        if (index == 0) break;
-        index--;
-      }
-    }
-  }
+  m_includeFileIndex.build(pp->getIncludeFileInfo(), m_fileId);
 }
 
 SymbolId ParseFile::getFileId(unsigned int line) {
@@ -226,23 +211,8 @@ SymbolId ParseFile::getFileId(unsigned int line) {
   if (!pp) return 0;
   auto& infos = pp->getIncludeFileInfo();
   if (!infos.empty()) {
-    if (!fileInfoCache.empty()) {
-      if (line > fileInfoCache.size()) {
-        SymbolId fileId = registerSymbol("CACHE OUT OF BOUND");
-        Location ppfile(fileId);
-        Error err(ErrorDefinition::PA_INTERNAL_ERROR, ppfile);
-        addError(err);
-      }
-      return fileInfoCache[line];
-    }
-    buildLineInfoCache_();
-    if (line > fileInfoCache.size()) {
-      SymbolId fileId = registerSymbol("CACHE OUT OF BOUND");
-      Location ppfile(fileId);
-      Error err(ErrorDefinition::PA_INTERNAL_ERROR, ppfile);
-      addError(err);
-    }
-    return fileInfoCache[line];
+    if (m_includeFileIndex.empty()) buildLineInfoCache_();
+    return m_includeFileIndex.translate(line).first;
   } else {
     return m_fileId;
   }
@@ -254,23 +224,8 @@ unsigned int ParseFile::getLineNb(unsigned int line) {
   if (!pp) return 0;
   auto& infos = pp->getIncludeFileInfo();
   if (!infos.empty()) {
-    if (!lineInfoCache.empty()) {
-      if (line > lineInfoCache.size()) {
-        SymbolId fileId = registerSymbol("CACHE OUT OF BOUND");
-        Location ppfile(fileId);
-        Error err(ErrorDefinition::PA_INTERNAL_ERROR, ppfile);
-        addError(err);
-      }
-      return lineInfoCache[line];
-    }
-    buildLineInfoCache_();
-    if (line > lineInfoCache.size()) {
-      SymbolId fileId = registerSymbol("CACHE OUT OF BOUND");
-      Location ppfile(fileId);
-      Error err(ErrorDefinition::PA_INTERNAL_ERROR, ppfile);
-      addError(err);
-    }
-    return lineInfoCache[line];
+    if (m_includeFileIndex.empty()) buildLineInfoCache_();
+    return m_includeFileIndex.translate(line).second;
   } else {
     return line;
   }
@@ -283,10 +238,9 @@ bool ParseFile::parseOneFile_(const std::string& fileName,
   Timer tmr;
   AntlrParserHandler* antlrParserHandler = new AntlrParserHandler();
   m_antlrParserHandler = antlrParserHandler;
-  std::ifstream stream;
-  std::stringstream ss(m_sourceText);
-  if (m_sourceText.empty()) {
-    stream.open(fileName);
+  std::string text = m_sourceText;
+  if (text.empty()) {
+    std::ifstream stream(fileName, std::ios::in | std::ios::binary);
     if (!stream.good()) {
       SymbolId fileId = registerSymbol(fileName);
       Location ppfile(fileId);
@@ -294,57 +248,70 @@ bool ParseFile::parseOneFile_(const std::string& fileName,
       addError(err);
       return false;
     }
-    antlrParserHandler->m_inputStream = new antlr4::ANTLRInputStream(stream);
-    stream.close();
-  } else {
-    antlrParserHandler->m_inputStream = new antlr4::ANTLRInputStream(ss);
+    text.assign(std::istreambuf_iterator<char>(stream),
+                std::istreambuf_iterator<char>());
   }
 
   antlrParserHandler->m_errorListener =
       new AntlrParserErrorListener(this, false, lineOffset, fileName);
-  antlrParserHandler->m_lexer =
-      new SV3_1aLexer(antlrParserHandler->m_inputStream);
   std::string suffix = StringUtils::leaf(fileName);
   VerilogVersion version = VerilogVersion::SystemVerilog;
   if (pp) version = pp->getVerilogVersion();
+  bool sverilog = false;
   if (version != VerilogVersion::NoVersion) {
     switch (version) {
       case VerilogVersion::NoVersion:
         break;
       case VerilogVersion::Verilog1995:
-        antlrParserHandler->m_lexer->sverilog = false;
+        sverilog = false;
         break;
       case VerilogVersion::Verilog2001:
-        antlrParserHandler->m_lexer->sverilog = false;
+        sverilog = false;
         break;
       case VerilogVersion::Verilog2005:
-        antlrParserHandler->m_lexer->sverilog = false;
+        sverilog = false;
         break;
       case VerilogVersion::SVerilog2005:
-        antlrParserHandler->m_lexer->sverilog = true;
+        sverilog = true;
         break;
       case VerilogVersion::Verilog2009:
-        antlrParserHandler->m_lexer->sverilog = true;
+        sverilog = true;
         break;
       case VerilogVersion::SystemVerilog:
-        antlrParserHandler->m_lexer->sverilog = true;
+        sverilog = true;
         break;
     }
   } else {
     fs::path baseFileName = FileUtils::basename(fileName);
     if ((suffix == "sv") || (clp->fullSVMode()) ||
         (clp->isSVFile(baseFileName))) {
-      antlrParserHandler->m_lexer->sverilog = true;
+      sverilog = true;
     } else {
-      antlrParserHandler->m_lexer->sverilog = false;
+      sverilog = false;
     }
   }
 
-  antlrParserHandler->m_lexer->removeErrorListeners();
-  antlrParserHandler->m_lexer->addErrorListener(
-      antlrParserHandler->m_errorListener);
-  antlrParserHandler->m_tokens =
-      new antlr4::CommonTokenStream(antlrParserHandler->m_lexer);
+  if (clp->fastLexer()) {
+    // No diagnostics are lost: like the ANY rule of SV3_1aLexer, the fast
+    // lexer turns any unmatched character into an ANY token, it has no
+    // recognition error to report
+    antlrParserHandler->m_fastLexer =
+        new SV3_1aFastLexer(std::move(text), fileName);
+    antlrParserHandler->m_fastLexer->sverilog = sverilog;
+    antlrParserHandler->m_tokens =
+        new antlr4::CommonTokenStream(antlrParserHandler->m_fastLexer);
+  } else {
+    antlrParserHandler->m_inputStream =
+        new ByteCharStream(std::move(text), fileName);
+    antlrParserHandler->m_lexer =
+        new SV3_1aLexer(antlrParserHandler->m_inputStream);
+    antlrParserHandler->m_lexer->sverilog = sverilog;
+    antlrParserHandler->m_lexer->removeErrorListeners();
+    antlrParserHandler->m_lexer->addErrorListener(
+        antlrParserHandler->m_errorListener);
+    antlrParserHandler->m_tokens =
+        new antlr4::CommonTokenStream(antlrParserHandler->m_lexer);
+  }
   antlrParserHandler->m_tokens->fill();
 
   if (getCompileSourceFile()->getCommandLineParser()->profile()) {
@@ -362,8 +329,20 @@ bool ParseFile::parseOneFile_(const std::string& fileName,
       ->getInterpreter<antlr4::atn::ParserATNSimulator>()
       ->setPredictionMode(antlr4::atn::PredictionMode::SLL);
   m_antlrParserHandler->m_parser->removeErrorListeners();
-  m_antlrParserHandler->m_parser->setErrorHandler(
-      std::make_shared<antlr4::BailErrorStrategy>());
+  std::shared_ptr<SLLBailErrorStrategy> bailStrategy =
+      std::make_shared<SLLBailErrorStrategy>();
+  m_antlrParserHandler->m_parser->setErrorHandler(bailStrategy);
+
+  // Build the AST while parsing, the python listener needs the full tree.
+  // Split files are walked by their parent, see parse().
+  std::unique_ptr<SV3_1aStreamingListener> streamingListener;
+  if (clp->streamParse() && !clp->pythonListener() && (m_parent == nullptr)) {
+    m_listener = new SV3_1aTreeShapeListener(
+        this, m_antlrParserHandler->m_tokens, lineOffset);
+    streamingListener = std::make_unique<SV3_1aStreamingListener>(
+        m_listener, m_antlrParserHandler->m_parser);
+    m_antlrParserHandler->m_parser->addParseListener(streamingListener.get());
+  }
 
   try {
     m_antlrParserHandler->m_tree =
@@ -377,69 +356,147 @@ bool ParseFile::parseOneFile_(const std::string& fileName,
       profileParser();
     }
   } catch (antlr4::ParseCancellationException& pex) {
-    m_antlrParserHandler->m_tokens->reset();
-    m_antlrParserHandler->m_parser->reset();
-    m_antlrParserHandler->m_parser->removeErrorListeners();
-    if (getCompileSourceFile()->getCommandLineParser()->profile()) {
-      m_antlrParserHandler->m_parser->setProfile(true);
-    }
-    m_antlrParserHandler->m_parser->setErrorHandler(
-        std::make_shared<antlr4::DefaultErrorStrategy>());
-    antlrParserHandler->m_parser->addErrorListener(
-        antlrParserHandler->m_errorListener);
-    antlrParserHandler->m_parser
-        ->getInterpreter<antlr4::atn::ParserATNSimulator>()
-        ->setPredictionMode(antlr4::atn::PredictionMode::LL);
-    antlrParserHandler->m_tree = antlrParserHandler->m_parser->top_level_rule();
+    // Only re-parse in LL mode the top-level description SLL failed on
+    if (resumeAfterSLLFailure_(bailStrategy->m_failedContext)) {
+      if (streamingListener) {
+        streamingListener->finish(static_cast<antlr4::ParserRuleContext*>(
+            m_antlrParserHandler->m_tree));
+      }
+      if (getCompileSourceFile()->getCommandLineParser()->profile()) {
+        std::string lines;
+        for (unsigned int line : m_sllFallbackLines) {
+          if (!lines.empty()) lines += ",";
+          lines += std::to_string(getLineNb(line + lineOffset));
+        }
+        m_profileInfo +=
+            "SLL Parsing: " + StringUtils::to_string(tmr.elapsed_rounded()) +
+            "s " + fileName + ", " + std::to_string(m_sllFallbackLines.size()) +
+            " LL fallback(s) at line(s) " + lines + "\n";
+        tmr.reset();
+        profileParser();
+      }
+    } else {
+      if (streamingListener) streamingListener->restart();
+      m_antlrParserHandler->m_tokens->reset();
+      m_antlrParserHandler->m_parser->reset();
+      m_antlrParserHandler->m_parser->removeErrorListeners();
+      if (getCompileSourceFile()->getCommandLineParser()->profile()) {
+        m_antlrParserHandler->m_parser->setProfile(true);
+      }
+      m_antlrParserHandler->m_parser->setErrorHandler(
+          std::make_shared<antlr4::DefaultErrorStrategy>());
+      antlrParserHandler->m_parser->addErrorListener(
+          antlrParserHandler->m_errorListener);
+      antlrParserHandler->m_parser
+          ->getInterpreter<antlr4::atn::ParserATNSimulator>()
+          ->setPredictionMode(antlr4::atn::PredictionMode::LL);
+      antlrParserHandler->m_tree =
+          antlrParserHandler->m_parser->top_level_rule();
 
-    if (getCompileSourceFile()->getCommandLineParser()->profile()) {
-      m_profileInfo +=
-          "LL  Parsing: " + StringUtils::to_string(tmr.elapsed_rounded()) +
-          " " + fileName + "\n";
-      tmr.reset();
-      profileParser();
+      if (getCompileSourceFile()->getCommandLineParser()->profile()) {
+        m_profileInfo +=
+            "LL  Parsing: " + StringUtils::to_string(tmr.elapsed_rounded()) +
+            " " + fileName + "\n";
+        tmr.reset();
+        profileParser();
+      }
     }
   }
+  if (streamingListener) {
+    m_antlrParserHandler->m_parser->removeParseListeners();
+  }
   /* Failed attempt to minimize memory usage:
      m_antlrParserHandler->m_parser->getInterpreter<antlr4::atn::ParserATNSimulator>()->clearDFA();
      SV3_1aParser::_sharedContextCache.clear();
   */
-  if (m_sourceText.empty()) {
-    stream.close();
+  return true;
+}
+
+bool ParseFile::resumeAfterSLLFailure_(
+    antlr4::ParserRuleContext* failedContext) {
+  // Find the top-level description SLL failed in:
+  // top_level_rule -> source_text -> description -> ... -> failedContext
+  antlr4::ParserRuleContext* description = failedContext;
+  while (description &&
+         (description->getRuleIndex() != SV3_1aParser::RuleDescription)) {
+    description =
+        static_cast<antlr4::ParserRuleContext*>(description->parent);
+  }
+  if ((description == nullptr) || (description->start == nullptr)) {
+    return false;
+  }
+  antlr4::ParserRuleContext* sourceText =
+      static_cast<antlr4::ParserRuleContext*>(description->parent);
+  if ((sourceText == nullptr) ||
+      (sourceText->getRuleIndex() != SV3_1aParser::RuleSource_text) ||
+      sourceText->children.empty() ||
+      (sourceText->children.back() != description)) {
+    return false;
+  }
+  antlr4::ParserRuleContext* topLevel =
+      static_cast<antlr4::ParserRuleContext*>(sourceText->parent);
+  if (topLevel == nullptr) return false;
+
+  SV3_1aParser* const parser = m_antlrParserHandler->m_parser;
+  antlr4::CommonTokenStream* const tokens = m_antlrParserHandler->m_tokens;
+  antlr4::atn::ParserATNSimulator* const simulator =
+      parser->getInterpreter<antlr4::atn::ParserATNSimulator>();
+  // Descriptions are re-entered exactly as from source_text's loop, so
+  // full-context predictions see the same outer context.
+  const size_t invokingState = description->invokingState;
+
+  // Drop the partial description, keep the ones SLL completed
+  std::exception_ptr noException;
+  sourceText->removeLastChild();
+  sourceText->exception = noException;
+  topLevel->exception = noException;
+  tokens->seek(description->start->getTokenIndex());
+
+  bool sll = false;  // The first description is known to fail in SLL mode
+  while (tokens->LA(1) != antlr4::Token::EOF) {
+    const size_t startIndex = tokens->index();
+    if (sll) {
+      parser->removeErrorListeners();
+      parser->setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+      simulator->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+      try {
+        parser->setContext(sourceText);
+        parser->setState(invokingState);
+        parser->description();
+        continue;
+      } catch (antlr4::ParseCancellationException& pex) {
+        sourceText->removeLastChild();
+        sourceText->exception = noException;
+        topLevel->exception = noException;
+        tokens->seek(startIndex);
+      }
+    }
+    m_sllFallbackLines.push_back(tokens->LT(1)->getLine());
+    parser->setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+    parser->addErrorListener(m_antlrParserHandler->m_errorListener);
+    simulator->setPredictionMode(antlr4::atn::PredictionMode::LL);
+    parser->setContext(sourceText);
+    parser->setState(invokingState);
+    parser->description();
+    // Error recovery may not consume anything, make sure the loop progresses
+    if (tokens->index() == startIndex) parser->consume();
+    sll = true;
   }
+
+  // Complete the tree as top_level_rule would: source_text EOF
+  sourceText->stop = tokens->LT(-1);
+  topLevel->addChild(parser->createTerminalNode(tokens->LT(1)));
+  topLevel->stop = tokens->LT(-1);
+  parser->setContext(nullptr);
+  m_antlrParserHandler->m_tree = topLevel;
   return true;
 }
 
 void ParseFile::profileParser() {
-  // Core dumps
-  /*
-  for (auto iterator =
-  m_antlrParserHandler->m_parser->getParseInfo().getDecisionInfo().begin();
-       iterator !=
-  m_antlrParserHandler->m_parser->getParseInfo().getDecisionInfo().end();
-  iterator++) { antlr4::atn::DecisionInfo& decisionInfo = *iterator;
-    antlr4::atn::DecisionState* ds =
-        m_antlrParserHandler->m_parser->getATN().getDecisionState(decisionInfo.decision);
-    std::string rule =
-  m_antlrParserHandler->m_parser->getRuleNames()[ds->ruleIndex]; if
-  (decisionInfo.timeInPrediction > 0) { std::cout << std::left << std::setw(35)
-  << std::setfill(' ') << rule; std::cout << std::left << std::setw(15) <<
-  std::setfill(' ')
-                << decisionInfo.timeInPrediction;
-      std::cout << std::left << std::setw(15) << std::setfill(' ')
-                << decisionInfo.invocations;
-      std::cout << std::left << std::setw(15) << std::setfill(' ')
-                << decisionInfo.SLL_TotalLook;
-      std::cout << std::left << std::setw(15) << std::setfill(' ')
-                << decisionInfo.SLL_MaxLook;
-      std::cout << std::left << std::setw(15) << std::setfill(' ')
-                << decisionInfo.ambiguities.size();
-      std::cout << std::left << std::setw(15) << std::setfill(' ')
-                << decisionInfo.errors.size();
-      std::cout << std::endl;
-    }
+  // Aggregated over all the files, reported by the Compiler
+  if (Compiler* compiler = getCompileSourceFile()->getCompiler()) {
+    compiler->getParserProfiler().record(m_antlrParserHandler->m_parser);
   }
-  */
 }
 
 std::string ParseFile::getProfileInfo() {
@@ -505,10 +562,13 @@ bool ParseFile::parse() {
     if ((m_parent == nullptr) && (m_children.empty())) {
       Timer tmr;
 
-      m_listener = new SV3_1aTreeShapeListener(
-          this, m_antlrParserHandler->m_tokens, m_offsetLine);
-      antlr4::tree::ParseTreeWalker::DEFAULT.walk(m_listener,
-                                                  m_antlrParserHandler->m_tree);
+      // Already built while parsing with -streamparse
+      if (m_listener == nullptr) {
+        m_listener = new SV3_1aTreeShapeListener(
+            this, m_antlrParserHandler->m_tokens, m_offsetLine);
+        antlr4::tree::ParseTreeWalker::DEFAULT.walk(
+            m_listener, m_antlrParserHandler->m_tree);
+      }
 
       if (debug_AstModel && !precompiled)
         std::cout << m_fileContent->printObjects();
@@ -523,6 +583,7 @@ bool ParseFile::parse() {
       if (!cache.save()) {
         return false;
       }
+      if (!m_keepParserHandler) releaseParserHandler();
 
       if (getCompileSourceFile()->getCommandLineParser()->profile()) {
         m_profileInfo +=
@@ -535,35 +596,61 @@ bool ParseFile::parse() {
     }
 
     if (!m_children.empty()) {
-      for (unsigned int i = 0; i < m_children.size(); i++) {
-        if (m_children[i]->m_antlrParserHandler) {
-          // Only visit the chunks that got re-parsed
-          // TODO: Incrementally regenerate the FileContent
-          m_children[i]->m_fileContent->setParent(m_fileContent);
-          m_children[i]->m_listener = new SV3_1aTreeShapeListener(
-              m_children[i], m_children[i]->m_antlrParserHandler->m_tokens,
-              m_children[i]->m_offsetLine);
-
-          Timer tmr;
-          antlr4::tree::ParseTreeWalker::DEFAULT.walk(
-              m_children[i]->m_listener,
-              m_children[i]->m_antlrParserHandler->m_tree);
-
-          if (getCompileSourceFile()->getCommandLineParser()->profile()) {
-            // m_profileInfo += "For file " + getSymbol
-            // (m_children[i]->m_ppFileId) + ", AST Walking took" +
-            // std::to_string (tmr.elapsed_rounded ()) + "\n";
-            tmr.reset();
-          }
-
-          if (debug_AstModel && !precompiled)
-            std::cout << m_children[i]->m_fileContent->printObjects();
-
-          ParseCache cache(m_children[i]);
-          if (!cache.save()) {
-            return false;
-          }
+      // Only visit the chunks that got re-parsed
+      // TODO: Incrementally regenerate the FileContent
+      std::vector<ParseFile*> chunks;
+      for (ParseFile* child : m_children) {
+        if (child->m_antlrParserHandler) chunks.push_back(child);
+      }
+
+      // The chunks are walked in order: a chunk's design elements get the
+      // `timescale and `default_nettype recorded by the chunks before it in
+      // the shared CompilationUnit, and their ids in chunk order
+      Timer tmr;
+      for (ParseFile* chunk : chunks) {
+        chunk->m_fileContent->setParent(m_fileContent);
+        chunk->m_listener = new SV3_1aTreeShapeListener(
+            chunk, chunk->m_antlrParserHandler->m_tokens, chunk->m_offsetLine);
+        antlr4::tree::ParseTreeWalker::DEFAULT.walk(
+            chunk->m_listener, chunk->m_antlrParserHandler->m_tree);
+      }
+
+      // Each chunk has its own FileContent and ErrorContainer, their caches
+      // are saved in parallel
+      std::vector<char> saved(chunks.size(), false);
+      const unsigned int maxThreadCount = std::min<unsigned int>(
+          getCompileSourceFile()->getCommandLineParser()->getNbMaxTreads(),
+          chunks.size());
+      if (maxThreadCount <= 1) {
+        for (unsigned int i = 0; i < chunks.size(); i++) {
+          ParseCache cache(chunks[i]);
+          saved[i] = cache.save();
         }
+      } else {
+        std::vector<std::thread> threads;
+        threads.reserve(maxThreadCount);
+        for (unsigned int t = 0; t < maxThreadCount; t++) {
+          threads.emplace_back([&chunks, &saved, maxThreadCount, t] {
+            for (unsigned int i = t; i < chunks.size(); i += maxThreadCount) {
+              ParseCache cache(chunks[i]);
+              saved[i] = cache.save();
+            }
+          });
+        }
+        for (std::thread& th : threads) th.join();
+      }
+
+      if (getCompileSourceFile()->getCommandLineParser()->profile()) {
+        m_profileInfo += "Chunks AST walking and cache saving: " +
+                         std::to_string(tmr.elapsed_rounded()) + "s\n";
+        tmr.reset();
+      }
+
+      for (unsigned int i = 0; i < chunks.size(); i++) {
+        if (debug_AstModel && !precompiled)
+          std::cout << chunks[i]->m_fileContent->printObjects();
+        if (!saved[i]) return false;
+        if (!m_keepParserHandler) chunks[i]->releaseParserHandler();
       }
     }
   }
@@ -14,12 +14,24 @@
  limitations under the License.
 */
 
+#include <Surelog/CommandLine/CommandLineParser.h>
 #include <Surelog/Design/FileContent.h>
+#include <Surelog/ErrorReporting/ErrorContainer.h>
+#include <Surelog/Library/Library.h>
+#include <Surelog/SourceCompile/AntlrParserHandler.h>
+#include <Surelog/SourceCompile/CompilationUnit.h>
+#include <Surelog/SourceCompile/CompileSourceFile.h>
+#include <Surelog/SourceCompile/Compiler.h>
 #include <Surelog/SourceCompile/ParseFile.h>
 #include <Surelog/SourceCompile/ParserHarness.h>
 #include <Surelog/SourceCompile/SymbolTable.h>
+#include <antlr4-runtime.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <parser/SV3_1aLexer.h>
+#include <parser/SV3_1aParser.h>
+
+#include <string>
 
 namespace SURELOG {
 using ::testing::ElementsAre;
@@ -57,5 +69,141 @@ TEST(ParserTest, BasicParse) {
     EXPECT_EQ(fC->Type(Unary_Not), slUnary_Not);
   }
 }
+
+std::string parseObjects(const std::string& content, bool streamParse,
+                         bool fastLexer = false, size_t* nbErrors = nullptr) {
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  clp.setCacheAllowed(false);
+  clp.setStreamParse(streamParse);
+  clp.setFastLexer(fastLexer);
+  Compiler compiler(&clp, &errors, &symbols);
+  ParserHarness harness;
+  FileContent* fC = harness.parse(content, &compiler, "");
+  if (nbErrors) *nbErrors = errors.getErrors().size();
+  return fC ? fC->printObjects() : "";
+}
+
+TEST(ParserTest, StreamParse) {
+  const std::string content =
+      "`timescale 1ns/1ps\n"
+      "package p; parameter P = 1 + 2 * 3; endpackage\n"
+      "module top #(parameter W = 8) (input logic [W-1:0] a);\n"
+      "  assign b = (a & ~c) | d << 2;\n"
+      "  always @(posedge clk) if (a ##1 b) x <= y;\n"  // Syntax error
+      "endmodule\n"
+      "class C; function int f(); return p::P ? 1 : 0; endfunction endclass\n"
+      "interface I; endinterface\n";
+  const std::string expected = parseObjects(content, false);
+  EXPECT_NE(expected, "");
+  EXPECT_EQ(parseObjects(content, true), expected);
+}
+
+TEST(ParserTest, FastLexer) {
+  const std::string content =
+      "module top #(parameter W = 8) (input logic [W-1:0] a);\n"
+      "  assign b = (a & ~c) | d << 2; // comment\n"
+      "endmodule\n";
+  size_t nbErrors = 0;
+  size_t nbFastErrors = 0;
+  const std::string expected = parseObjects(content, false, false, &nbErrors);
+  EXPECT_NE(expected, "");
+  EXPECT_EQ(parseObjects(content, false, true, &nbFastErrors), expected);
+  EXPECT_EQ(nbFastErrors, nbErrors);
+
+  // A character no token matches is an ANY token for both lexers, the
+  // parser reports it: same objects and diagnostics
+  const std::string unmatched = "module top; \x01 endmodule\n";
+  const std::string unmatchedExpected =
+      parseObjects(unmatched, false, false, &nbErrors);
+  EXPECT_GT(nbErrors, 0);
+  EXPECT_EQ(parseObjects(unmatched, false, true, &nbFastErrors),
+            unmatchedExpected);
+  EXPECT_EQ(nbFastErrors, nbErrors);
+}
+struct ParseTree {
+  std::string m_text;
+  size_t m_nbErrors = 0;
+  std::string m_profile;
+};
+
+// ANTLR tree of a ParseFile parse: SLL first, resumed in LL mode from the
+// description SLL bails out on
+ParseTree parseTree(const std::string& content) {
+  SymbolTable symbols;
+  ErrorContainer errors(&symbols);
+  CommandLineParser clp(&errors, &symbols, false, false);
+  clp.setCacheAllowed(false);
+  clp.setProfile(true);
+  Compiler compiler(&clp, &errors, &symbols);
+  CompilationUnit unit(false);
+  Library lib("work", &symbols);
+  CompileSourceFile csf(0, &clp, &errors, &compiler, &symbols, &unit, &lib);
+  ParseFile pf(content, &csf, &unit, &lib);
+  FileContent fC(0, &lib, &symbols, &errors, nullptr, 0);
+  pf.setFileContent(&fC);
+  EXPECT_TRUE(pf.parse());
+  AntlrParserHandler* const handler = pf.getAntlrParserHandler();
+  ParseTree result;
+  result.m_text = handler->m_tree->toStringTree(handler->m_parser);
+  result.m_nbErrors = handler->m_parser->getNumberOfSyntaxErrors();
+  result.m_profile = pf.getProfileInfo();
+  return result;
+}
+
+// ANTLR tree of a parse of the whole content in LL mode
+ParseTree parseTreeLL(const std::string& content) {
+  antlr4::ANTLRInputStream input(content);
+  SV3_1aLexer lexer(&input);
+  lexer.sverilog = true;
+  lexer.removeErrorListeners();
+  antlr4::CommonTokenStream tokens(&lexer);
+  SV3_1aParser parser(&tokens);
+  parser.removeErrorListeners();
+  parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(
+      antlr4::atn::PredictionMode::LL);
+  ParseTree result;
+  result.m_text = parser.top_level_rule()->toStringTree(&parser);
+  result.m_nbErrors = parser.getNumberOfSyntaxErrors();
+  return result;
+}
+
+TEST(ParserTest, ResumeAfterSLLFailure) {
+  // The syntax error in the second module makes SLL bail out mid-file, like
+  // a construct SLL cannot predict. Only that module is re-parsed in LL
+  // mode, the last one SLL-first again.
+  const std::string content =
+      "package p; parameter P = 1; endpackage\n"
+      "module a(input logic i, output logic o); assign o = i; endmodule\n"
+      "module b; assign = ; always @(posedge clk) x <= y; endmodule\n"
+      "module c; logic [3:0] v; assign v = p::P + 1; endmodule\n";
+  const ParseTree resumed = parseTree(content);
+  const ParseTree expected = parseTreeLL(content);
+  EXPECT_GT(expected.m_nbErrors, 0);
+  EXPECT_EQ(resumed.m_text, expected.m_text);
+  EXPECT_EQ(resumed.m_nbErrors, expected.m_nbErrors);
+  EXPECT_NE(resumed.m_profile.find(" 1 LL fallback(s)"), std::string::npos)
+      << resumed.m_profile;
+
+  // Bail-out in the first and in the last description
+  for (const std::string& text :
+       {std::string("module a; assign = ; endmodule\n"
+                    "module b; assign x = y; endmodule\n"),
+        std::string("module a; assign x = y; endmodule\n"
+                    "module b; assign x = ; endmodule\n")}) {
+    const ParseTree resumedText = parseTree(text);
+    const ParseTree expectedText = parseTreeLL(text);
+    EXPECT_EQ(resumedText.m_text, expectedText.m_text) << text;
+    EXPECT_EQ(resumedText.m_nbErrors, expectedText.m_nbErrors) << text;
+  }
+
+  // No bail-out, no fallback
+  const std::string clean =
+      "module a; assign x = y; endmodule\nmodule b; endmodule\n";
+  const ParseTree resumedClean = parseTree(clean);
+  EXPECT_EQ(resumedClean.m_text, parseTreeLL(clean).m_text);
+  EXPECT_EQ(resumedClean.m_profile.find("fallback"), std::string::npos);
+}
 }  // namespace
 }  // namespace SURELOG
@@ -0,0 +1,194 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/ParserProfiler.h>
+#include <antlr4-runtime.h>
+#include <atn/DecisionInfo.h>
+#include <atn/ParseInfo.h>
+#include <atn/ProfilingATNSimulator.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace SURELOG {
+
+namespace fs = std::filesystem;
+
+void ParserProfiler::record(antlr4::Parser* parser) {
+  // getParseInfo() requires the profiling simulator
+  antlr4::atn::ProfilingATNSimulator* simulator =
+      parser->getInterpreter<antlr4::atn::ProfilingATNSimulator>();
+  if (simulator == nullptr) return;
+  const std::vector<std::string>& ruleNames = parser->getRuleNames();
+  const antlr4::atn::ATN& atn = parser->getATN();
+  // getDecisionInfo() returns a copy, keep it alive while iterating
+  const std::vector<antlr4::atn::DecisionInfo> decisions =
+      simulator->getDecisionInfo();
+  for (const antlr4::atn::DecisionInfo& info : decisions) {
+    if (info.invocations == 0) continue;
+    const antlr4::atn::DecisionState* state =
+        atn.getDecisionState(info.decision);
+    record((state && (state->ruleIndex < ruleNames.size()))
+               ? std::string_view(ruleNames[state->ruleIndex])
+               : std::string_view("?"),
+           info);
+  }
+}
+
+void ParserProfiler::record(std::string_view rule,
+                            const antlr4::atn::DecisionInfo& info) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Decision& decision = m_decisions[info.decision];
+  if (decision.m_rule.empty()) decision.m_rule = rule;
+  ++decision.m_files;
+  decision.m_invocations += info.invocations;
+  decision.m_timeInPrediction += info.timeInPrediction;
+  decision.m_sllTotalLook += info.SLL_TotalLook;
+  decision.m_sllMaxLook = std::max<uint64_t>(decision.m_sllMaxLook,
+                                             info.SLL_MaxLook);
+  decision.m_sllATNTransitions += info.SLL_ATNTransitions;
+  decision.m_sllDFATransitions += info.SLL_DFATransitions;
+  decision.m_llFallback += info.LL_Fallback;
+  decision.m_llTotalLook += info.LL_TotalLook;
+  decision.m_llMaxLook = std::max<uint64_t>(decision.m_llMaxLook,
+                                            info.LL_MaxLook);
+  decision.m_llATNTransitions += info.LL_ATNTransitions;
+  decision.m_llDFATransitions += info.LL_DFATransitions;
+  decision.m_ambiguities += info.ambiguities.size();
+  decision.m_contextSensitivities += info.contextSensitivities.size();
+  decision.m_errors += info.errors.size();
+  decision.m_predicateEvals += info.predicateEvals.size();
+}
+
+bool ParserProfiler::empty() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_decisions.empty();
+}
+
+std::vector<std::pair<size_t, ParserProfiler::Decision>>
+ParserProfiler::sortedDecisions_() const {
+  std::vector<std::pair<size_t, Decision>> decisions;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    decisions.assign(m_decisions.begin(), m_decisions.end());
+  }
+  std::stable_sort(decisions.begin(), decisions.end(),
+                   [](const std::pair<size_t, Decision>& lhs,
+                      const std::pair<size_t, Decision>& rhs) {
+                     return lhs.second.m_timeInPrediction >
+                            rhs.second.m_timeInPrediction;
+                   });
+  return decisions;
+}
+
+std::string ParserProfiler::toJSON() const {
+  const std::vector<std::pair<size_t, Decision>> decisions =
+      sortedDecisions_();
+
+  // Per rule totals, in the order of their most expensive decision
+  std::vector<std::string> ruleOrder;
+  std::map<std::string, Decision> rules;
+  uint64_t totalTime = 0;
+  for (const auto& [index, decision] : decisions) {
+    auto [it, inserted] = rules.emplace(decision.m_rule, Decision());
+    if (inserted) ruleOrder.push_back(decision.m_rule);
+    Decision& rule = it->second;
+    rule.m_invocations += decision.m_invocations;
+    rule.m_timeInPrediction += decision.m_timeInPrediction;
+    rule.m_sllTotalLook += decision.m_sllTotalLook;
+    rule.m_sllMaxLook = std::max(rule.m_sllMaxLook, decision.m_sllMaxLook);
+    rule.m_llFallback += decision.m_llFallback;
+    rule.m_llTotalLook += decision.m_llTotalLook;
+    rule.m_llMaxLook = std::max(rule.m_llMaxLook, decision.m_llMaxLook);
+    rule.m_ambiguities += decision.m_ambiguities;
+    rule.m_errors += decision.m_errors;
+    totalTime += decision.m_timeInPrediction;
+  }
+
+  std::ostringstream out;
+  out << "{\n  \"total_time_in_prediction_ns\": " << totalTime << ",\n";
+  out << "  \"decisions\": [";
+  const char* separator = "\n";
+  for (const auto& [index, d] : decisions) {
+    out << separator << "    {\"decision\": " << index << ", \"rule\": \""
+        << d.m_rule << "\", \"files\": " << d.m_files
+        << ", \"invocations\": " << d.m_invocations
+        << ", \"time_in_prediction_ns\": " << d.m_timeInPrediction
+        << ", \"sll_total_look\": " << d.m_sllTotalLook
+        << ", \"sll_max_look\": " << d.m_sllMaxLook
+        << ", \"sll_atn_transitions\": " << d.m_sllATNTransitions
+        << ", \"sll_dfa_transitions\": " << d.m_sllDFATransitions
+        << ", \"ll_fallback\": " << d.m_llFallback
+        << ", \"ll_total_look\": " << d.m_llTotalLook
+        << ", \"ll_max_look\": " << d.m_llMaxLook
+        << ", \"ll_atn_transitions\": " << d.m_llATNTransitions
+        << ", \"ll_dfa_transitions\": " << d.m_llDFATransitions
+        << ", \"ambiguities\": " << d.m_ambiguities
+        << ", \"context_sensitivities\": " << d.m_contextSensitivities
+        << ", \"errors\": " << d.m_errors
+        << ", \"predicate_evals\": " << d.m_predicateEvals << "}";
+    separator = ",\n";
+  }
+  out << "\n  ],\n  \"rules\": [";
+  separator = "\n";
+  for (const std::string& name : ruleOrder) {
+    const Decision& r = rules[name];
+    out << separator << "    {\"rule\": \"" << name
+        << "\", \"invocations\": " << r.m_invocations
+        << ", \"time_in_prediction_ns\": " << r.m_timeInPrediction
+        << ", \"sll_total_look\": " << r.m_sllTotalLook
+        << ", \"sll_max_look\": " << r.m_sllMaxLook
+        << ", \"ll_fallback\": " << r.m_llFallback
+        << ", \"ll_total_look\": " << r.m_llTotalLook
+        << ", \"ll_max_look\": " << r.m_llMaxLook
+        << ", \"ambiguities\": " << r.m_ambiguities
+        << ", \"errors\": " << r.m_errors << "}";
+    separator = ",\n";
+  }
+  out << "\n  ]\n}\n";
+  return out.str();
+}
+
+std::string ParserProfiler::toCSV() const {
+  std::ostringstream out;
+  out << "decision,rule,files,invocations,time_in_prediction_ns,"
+         "sll_total_look,sll_max_look,sll_atn_transitions,"
+         "sll_dfa_transitions,ll_fallback,ll_total_look,ll_max_look,"
+         "ll_atn_transitions,ll_dfa_transitions,ambiguities,"
+         "context_sensitivities,errors,predicate_evals\n";
+  for (const auto& [index, d] : sortedDecisions_()) {
+    out << index << "," << d.m_rule << "," << d.m_files << ","
+        << d.m_invocations << "," << d.m_timeInPrediction << ","
+        << d.m_sllTotalLook << "," << d.m_sllMaxLook << ","
+        << d.m_sllATNTransitions << "," << d.m_sllDFATransitions << ","
+        << d.m_llFallback << "," << d.m_llTotalLook << "," << d.m_llMaxLook
+        << "," << d.m_llATNTransitions << "," << d.m_llDFATransitions << ","
+        << d.m_ambiguities << "," << d.m_contextSensitivities << ","
+        << d.m_errors << "," << d.m_predicateEvals << "\n";
+  }
+  return out.str();
+}
+
+bool ParserProfiler::write(const fs::path& fileName) const {
+  std::ofstream ofs(fileName);
+  if (!ofs.good()) return false;
+  ofs << ((fileName.extension() == ".csv") ? toCSV() : toJSON());
+  ofs.close();
+  return ofs.good();
+}
+
+}  // namespace SURELOG
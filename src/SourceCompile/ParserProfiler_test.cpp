@@ -0,0 +1,68 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/ParserProfiler.h>
+#include <antlr4-runtime.h>
+#include <atn/DecisionInfo.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace SURELOG {
+
+namespace {
+antlr4::atn::DecisionInfo makeInfo(size_t decision, long long invocations,
+                                   long long time, long long sllMaxLook,
+                                   long long llFallback) {
+  antlr4::atn::DecisionInfo info(decision);
+  info.invocations = invocations;
+  info.timeInPrediction = time;
+  info.SLL_TotalLook = invocations * sllMaxLook;
+  info.SLL_MaxLook = sllMaxLook;
+  info.LL_Fallback = llFallback;
+  return info;
+}
+
+TEST(ParserProfilerTest, AggregatesPerDecision) {
+  ParserProfiler profiler;
+  EXPECT_TRUE(profiler.empty());
+  profiler.record("expression", makeInfo(3, 10, 100, 2, 0));
+  profiler.record("module_item", makeInfo(7, 5, 1000, 4, 1));
+  profiler.record("expression", makeInfo(3, 20, 50, 6, 2));
+  EXPECT_FALSE(profiler.empty());
+
+  // Sorted by time in prediction, decision 3 summed across the 2 parses
+  const std::string csv = profiler.toCSV();
+  const std::string::size_type header = csv.find('\n');
+  ASSERT_NE(header, std::string::npos);
+  EXPECT_EQ(csv.substr(header + 1),
+            "7,module_item,1,5,1000,20,4,0,0,1,0,0,0,0,0,0,0,0\n"
+            "3,expression,2,30,150,140,6,0,0,2,0,0,0,0,0,0,0,0\n");
+
+  const std::string json = profiler.toJSON();
+  EXPECT_NE(json.find("\"total_time_in_prediction_ns\": 1150"),
+            std::string::npos);
+  EXPECT_NE(json.find("{\"decision\": 3, \"rule\": \"expression\", "
+                      "\"files\": 2, \"invocations\": 30, "
+                      "\"time_in_prediction_ns\": 150"),
+            std::string::npos);
+  EXPECT_NE(json.find("{\"rule\": \"module_item\", \"invocations\": 5"),
+            std::string::npos);
+  EXPECT_LT(json.find("\"rule\": \"module_item\""),
+            json.find("\"rule\": \"expression\""));
+}
+}  // namespace
+}  // namespace SURELOG
@@ -23,10 +23,12 @@
 
 #include <Surelog/Cache/PPCache.h>
 #include <Surelog/CommandLine/CommandLineParser.h>
+#include <Surelog/Design/Design.h>
 #include <Surelog/Design/FileContent.h>
 #include <Surelog/ErrorReporting/ErrorContainer.h>
 #include <Surelog/ErrorReporting/Waiver.h>
 #include <Surelog/Package/Precompiled.h>
+#include <Surelog/SourceCompile/ByteCharStream.h>
 #include <Surelog/SourceCompile/CompilationUnit.h>
 #include <Surelog/SourceCompile/CompileSourceFile.h>
 #include <Surelog/SourceCompile/Compiler.h>
@@ -41,9 +43,12 @@
 #include <parser/SV3_1aPpLexer.h>
 #include <parser/SV3_1aPpParser.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <regex>
 #include <string_view>
+#include <unordered_map>
 
 namespace SURELOG {
 
@@ -296,7 +301,7 @@ PreprocessFile::PreprocessFile(const PreprocessFile& orig) {}
 PreprocessFile::~PreprocessFile() {
   delete m_listener;
   if (!m_instructions.m_persist)
-    for (const auto& name_macro : m_macros) delete name_macro.second;
+    for (MacroInfo* macro : m_macros) delete macro;
 }
 
 PreprocessFile::AntlrParserHandler::~AntlrParserHandler() {
@@ -313,7 +318,7 @@ static size_t LinesCount(std::string_view s) {
 }
 
 bool PreprocessFile::preprocess() {
-  m_result = "";
+  m_result.clear();
   fs::path fileName = getSymbol(m_fileId);
   Precompiled* prec = Precompiled::getSingleton();
   fs::path root = FileUtils::basename(fileName);
@@ -340,12 +345,12 @@ bool PreprocessFile::preprocess() {
       if (m_debugPP) {
         std::cout << "PP PREPROCESS MACRO: " << m_macroBody << std::endl;
       }
-      m_antlrParserHandler->m_inputStream = new ANTLRInputStream(m_macroBody);
+      m_antlrParserHandler->m_inputStream =
+          new ByteCharStream(m_macroBody, fileName.string());
     } else {
       if (m_debugPP)
         std::cout << "PP PREPROCESS FILE: " << fileName << std::endl;
-      std::ifstream stream;
-      stream.open(fileName);
+      std::ifstream stream(fileName, std::ios::in | std::ios::binary);
       if (!stream.good()) {
         if (m_includer == nullptr) {
           Location loc(m_fileId);
@@ -359,35 +364,44 @@ bool PreprocessFile::preprocess() {
         }
         return false;
       }
-      // Remove ^M (DOS) from text file
+      // Single bulk read of the whole file
       std::string text;
-      char nonAscii;
-      char c = stream.get();
+      stream.seekg(0, std::ios::end);
+      const std::streamoff fileSize = stream.tellg();
+      if (fileSize > 0) {
+        text.resize(fileSize);
+        stream.seekg(0, std::ios::beg);
+        stream.read(text.data(), fileSize);
+        text.resize(stream.gcount());
+      } else if (fileSize < 0) {
+        // Not seekable (pipe, device...)
+        stream.clear();
+        text.assign(std::istreambuf_iterator<char>(stream),
+                    std::istreambuf_iterator<char>());
+      }
+      stream.close();
+
+      // Line and column of the (last) non-ASCII character are only computed
+      // when there is one. Columns count the ^M characters, as they are
+      // still present at this point.
+      char nonAscii = 0;
       bool nonAsciiContent = false;
-      int lineNb = 1;
-      int columnNb = 0;
       int lineNonAscii = 0;
       int columnNonAscii = 0;
-      while (stream.good()) {
-        if (c != 0x0D) {
-          if (isascii(c))
-            text += c;
-          else {
-            nonAscii = c;
-            lineNonAscii = lineNb;
-            columnNonAscii = columnNb;
-            text += " ";
-            nonAsciiContent = true;
-          }
-        }
-        if (c == '\n') {
-          lineNb++;
-          columnNb = 0;
-        }
-        columnNb++;
-        c = stream.get();
+      const std::string_view::size_type nonAsciiPos =
+          StringUtils::findLastNonAscii(text);
+      if (nonAsciiPos != std::string_view::npos) {
+        nonAsciiContent = true;
+        nonAscii = text[nonAsciiPos];
+        std::string_view before(text.data(), nonAsciiPos);
+        lineNonAscii = LinesCount(before) + 1;
+        const std::string_view::size_type lineStart = before.rfind('\n');
+        columnNonAscii = (lineStart == std::string_view::npos)
+                             ? nonAsciiPos
+                             : nonAsciiPos - lineStart;
       }
-      stream.close();
+      // Remove ^M (DOS) from text file, blank out non-ASCII characters
+      StringUtils::sanitizeSourceText(text);
 
       if (nonAsciiContent) {
         std::string symbol;
@@ -405,22 +419,26 @@ bool PreprocessFile::preprocess() {
         }
       }
 
-      try {
-        m_antlrParserHandler->m_inputStream = new ANTLRInputStream(text);
-      } catch (...) {
-        Location loc(0);
-        if (m_includer == nullptr) {
-          Location file(m_fileId);
-          loc = file;
-        } else {
-          Location includeFile(m_includer->m_fileId, m_includerLine, 0,
-                               m_fileId);
-          loc = includeFile;
+      DesignElementKeyword lastKeyword = DesignElementKeyword::None;
+      if (isDirectiveFree_(text,
+                           !clp->filterComments() &&
+                               !clp->reportNonSynthesizable(),
+                           &lastKeyword)) {
+        delete m_antlrParserHandler;
+        m_antlrParserHandler = nullptr;
+        preprocessDirectiveFree_(text, lastKeyword);
+        if (clp->profile()) {
+          m_profileInfo += "PP Fast path: " +
+                           StringUtils::to_string(tmr.elapsed_rounded()) +
+                           "s " + fileName.string() + "\n";
         }
-        Error err(ErrorDefinition::PP_CANNOT_READ_FILE_CONTENT, loc);
-        addError(err);
-        return false;
+        if (m_debugAstModel && !precompiled)
+          std::cout << m_fileContent->printObjects();
+        return true;
       }
+
+      m_antlrParserHandler->m_inputStream =
+          new ByteCharStream(std::move(text), fileName.string());
     }
     m_antlrParserHandler->m_errorListener =
         new PreprocessFile::DescriptiveErrorListener(
@@ -499,7 +517,7 @@ bool PreprocessFile::preprocess() {
         (m_macroBody.empty()) ? m_fileId : getMacroSignature(),
         m_antlrParserHandler);
   }
-  m_result = "";
+  m_result.clear();
   m_lineCount = 0;
   delete m_listener;
   m_listener = new SV3_1aPpTreeShapeListener(
@@ -509,10 +527,125 @@ bool PreprocessFile::preprocess() {
                                       m_antlrParserHandler->m_pptree);
   if (m_debugAstModel && !precompiled)
     std::cout << m_fileContent->printObjects();
-  m_lineCount = LinesCount(m_result);
+  m_lineCount = m_result.lineCount();
   return true;
 }
 
+static bool isPpNumberChar(char c) {
+  switch (c) {
+    case ' ':
+    case '_':
+    case '\'':
+    case '?':
+    case 'x':
+    case 'X':
+    case 'z':
+    case 'Z':
+    case 's':
+    case 'S':
+    case 'o':
+    case 'O':
+    case 'h':
+    case 'H':
+      return true;
+    default:
+      return isxdigit(static_cast<unsigned char>(c));
+  }
+}
+
+bool PreprocessFile::isDirectiveFree_(std::string_view text,
+                                      bool keepComments,
+                                      DesignElementKeyword* lastKeyword) {
+  // Follows the SV3_1aPpLexer tokens that the listener does not copy
+  // verbatim. Outside of comments and strings: no directive or macro, no
+  // escaped identifier, no space inside Number tokens (they get squeezed).
+  // Comments and strings are skipped with memchr-based searches.
+  // The listener also tracks whether the text ends inside a design element,
+  // the last of the design element keywords is reported for that.
+  // Keywords as spelled in SV3_1aPpLexer.g4 (PRIMITIVE is 'primivite').
+  static const std::unordered_map<std::string_view, DesignElementKeyword>
+      keywords = {{"module", DesignElementKeyword::Begin},
+                  {"endmodule", DesignElementKeyword::End},
+                  {"interface", DesignElementKeyword::Begin},
+                  {"endinterface", DesignElementKeyword::End},
+                  {"program", DesignElementKeyword::Begin},
+                  {"endprogram", DesignElementKeyword::End},
+                  {"primivite", DesignElementKeyword::Begin},
+                  {"endprimitive", DesignElementKeyword::End},
+                  {"package", DesignElementKeyword::Begin},
+                  {"endpackage", DesignElementKeyword::End},
+                  {"checker", DesignElementKeyword::Begin},
+                  {"endchecker", DesignElementKeyword::End},
+                  {"config", DesignElementKeyword::Begin},
+                  {"endconfig", DesignElementKeyword::End}};
+  const size_t size = text.size();
+  size_t i = 0;
+  while (i < size) {
+    const char c = text[i];
+    if ((c == '/') && (i + 1 < size) && (text[i + 1] == '/')) {
+      if (!keepComments) return false;
+      size_t end = text.find('\n', i + 2);
+      if (end == std::string_view::npos) return false;
+      i = end + 1;
+    } else if ((c == '/') && (i + 1 < size) && (text[i + 1] == '*')) {
+      if (!keepComments) return false;
+      size_t end = text.find("*/", i + 2);
+      if (end == std::string_view::npos) return false;
+      i = end + 2;
+    } else if (c == '"') {
+      size_t end = text.find_first_of("\"\n`\\", i + 1);
+      if ((end == std::string_view::npos) || (text[end] != '"')) return false;
+      i = end + 1;
+    } else if ((c == '`') || (c == '\\')) {
+      return false;
+    } else if (isalpha(static_cast<unsigned char>(c)) || (c == '_')) {
+      const size_t start = i++;
+      while ((i < size) && (isalnum(static_cast<unsigned char>(text[i])) ||
+                            (text[i] == '_') || (text[i] == '$'))) {
+        i++;
+      }
+      auto keyword = keywords.find(text.substr(start, i - start));
+      if (keyword != keywords.end()) *lastKeyword = keyword->second;
+    } else if (isdigit(static_cast<unsigned char>(c)) || (c == '\'')) {
+      // Conservative: any space inside what could be a Number token
+      i++;
+      while ((i < size) && isPpNumberChar(text[i])) {
+        if ((text[i] == ' ') && (i + 1 < size) && isPpNumberChar(text[i + 1]))
+          return false;
+        i++;
+      }
+    } else {
+      i++;
+    }
+  }
+  return true;
+}
+
+void PreprocessFile::preprocessDirectiveFree_(
+    std::string_view text, DesignElementKeyword lastKeyword) {
+  // Same side effects as the SV3_1aPpTreeShapeListener walk
+  if (lastKeyword == DesignElementKeyword::Begin) {
+    getCompilationUnit()->setInDesignElement();
+  } else if (lastKeyword == DesignElementKeyword::End) {
+    getCompilationUnit()->unsetInDesignElement();
+  }
+  if (m_fileContent == nullptr) {
+    m_fileContent = new FileContent(
+        getFileId(0), m_library, getCompileSourceFile()->getSymbolTable(),
+        getCompileSourceFile()->getErrorContainer(), nullptr, 0);
+    getCompileSourceFile()->getCompiler()->getDesign()->addPPFileContent(
+        getFileId(0), m_fileContent);
+  }
+  getCompilationUnit()->setCurrentTimeInfo(getFileId(0));
+  m_result.clear();
+  m_lineCount = 0;
+  append(std::string(text));
+  // A single text blob stands for the whole content
+  m_fileContent->getVObjects().emplace_back(0, getFileId(0),
+                                            VObjectType::slText_blob, 1, 0,
+                                            m_lineCount + 1, 0);
+}
+
 unsigned int PreprocessFile::getSumLineCount() {
   unsigned int total = m_lineCount;
   if (m_includer) total += m_includer->getSumLineCount();
@@ -526,6 +659,13 @@ void PreprocessFile::append(const std::string& s) {
   }
 }
 
+void PreprocessFile::append(const PPOutputBuffer& included) {
+  if (!m_pauseAppend) {
+    m_lineCount += included.lineCount();
+    m_result.append(&included);
+  }
+}
+
 void PreprocessFile::recordMacro(const std::string& name, unsigned int line,
                                  unsigned short int column,
                                  const std::string& arguments,
@@ -561,8 +701,9 @@ void PreprocessFile::recordMacro(const std::string& name, unsigned int line,
   MacroInfo* macroInfo = new MacroInfo(
       name, arguments.empty() ? MacroInfo::NO_ARGS : MacroInfo::WITH_ARGS,
       getFileId(line), line, column, args, tokens);
-  m_macros.insert(std::make_pair(name, macroInfo));
-  m_compilationUnit->registerMacroInfo(name, macroInfo);
+  const SymbolId macroId = m_compilationUnit->registerMacroName(name);
+  m_macros.insert(macroId, macroInfo);
+  m_compilationUnit->registerMacroInfo(macroId, macroInfo);
   checkMacroArguments_(name, line, column, args, tokens);
 }
 
@@ -579,15 +720,16 @@ std::string PreprocessFile::reportIncludeInfo() const {
   return strm.str();
 }
 
-void PreprocessFile::recordMacro(const std::string& name, unsigned int line,
-                                 unsigned short int column,
-                                 const std::vector<std::string>& arguments,
-                                 const std::vector<std::string>& tokens) {
+void PreprocessFile::recordMacro(
+    std::string_view name, unsigned int line, unsigned short int column,
+    const std::vector<std::string_view>& arguments,
+    const std::vector<std::string_view>& tokens) {
   MacroInfo* macroInfo = new MacroInfo(
       name, arguments.empty() ? MacroInfo::NO_ARGS : MacroInfo::WITH_ARGS,
       getFileId(line), line, column, arguments, tokens);
-  m_macros.insert(std::make_pair(name, macroInfo));
-  m_compilationUnit->registerMacroInfo(name, macroInfo);
+  const SymbolId macroId = m_compilationUnit->registerMacroName(name);
+  m_macros.insert(macroId, macroInfo);
+  m_compilationUnit->registerMacroInfo(macroId, macroInfo);
 }
 
 void PreprocessFile::checkMacroArguments_(
@@ -729,12 +871,14 @@ std::pair<bool, std::string> PreprocessFile::evaluateMacro_(
     SymbolId embeddedMacroCallFile) {
   std::string result;
   bool found = false;
-  const std::vector<std::string>& formal_args = macroInfo->m_arguments;
-  const std::vector<std::string>& orig_body_tokens = macroInfo->m_tokens;
+  const std::vector<std::string_view>& formal_args = macroInfo->m_arguments;
+  const std::vector<std::string_view>& orig_body_tokens = macroInfo->m_tokens;
 
   if (instructions.m_check_macro_loop) {
     bool loop = loopChecker.addEdge(callingFile->m_fileId, getId(name));
     if (loop) {
+      // Only the macros of the loop closed by this call: a macro reached
+      // through two paths (`A using `B and `C, `C using `B) is not one
       std::vector<SymbolId> loop = loopChecker.reportLoop();
       for (auto id : loop) {
         MacroInfo* macroInfo2 = m_compilationUnit->getMacroInfo(getSymbol(id));
@@ -753,13 +897,13 @@ std::pair<bool, std::string> PreprocessFile::evaluateMacro_(
   }
   // Don't modify the actual tokens of the macro, make a copy...
   std::vector<std::string> body_tokens;
-  for (const std::string& tok : orig_body_tokens) {
+  for (std::string_view tok : orig_body_tokens) {
     if (tok == "``_``") {
       body_tokens.push_back("``");
       body_tokens.push_back("_");
       body_tokens.push_back("``");
     } else {
-      body_tokens.push_back(tok);
+      body_tokens.emplace_back(tok);
     }
   }
 
@@ -1012,10 +1156,9 @@ bool PreprocessFile::deleteMacro(const std::string& name,
 
   // Try local file scope
   if (found == false) {
-    MacroStorage::iterator itr = m_macros.find(name);
-    if (itr != m_macros.end()) {
-      m_macros.erase(itr);
-      m_compilationUnit->deleteMacro(name);
+    const SymbolId macroId = m_compilationUnit->getMacroNameId(name);
+    if ((macroId != SymbolTable::getBadId()) && m_macros.erase(macroId)) {
+      m_compilationUnit->deleteMacro(macroId);
       found = true;
     }
   }
@@ -1174,29 +1317,25 @@ unsigned int PreprocessFile::getLineNb(unsigned int line) {
   }
 }
 
-std::string PreprocessFile::getPreProcessedFileContent() {
+const PPOutputBuffer& PreprocessFile::getPreProcessedOutput() {
   // If File is empty (Only CR) return an empty string
-  bool nonEmpty = false;
-  unsigned int pp_result_size = m_result.size();
-  for (unsigned int i = 0; i < pp_result_size; i++) {
-    if ((m_result[i] != '\n') && (m_result[i] != ' ')) {
-      nonEmpty = true;
-      break;
-    }
-  }
-  if (!nonEmpty) m_result = "";
+  if (m_result.isBlank()) m_result.clear();
   if (m_debugPPResult) {
     const fs::path fileName = getSymbol(m_fileId);
     std::string objName = (!m_macroBody.empty()) ? "macro " + m_macroBody
                                                  : "file " + fileName.string();
     std::cout << "PP RESULT for " << objName
               << " : \nvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv\n"
-              << m_result << "\n^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\n"
-              << std::endl;
+              << m_result.str()
+              << "\n^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\n" << std::endl;
   }
   return m_result;
 }
 
+std::string PreprocessFile::getPreProcessedFileContent() {
+  return getPreProcessedOutput().str();
+}
+
 PreprocessFile::IfElseStack& PreprocessFile::getStack() {
   PreprocessFile* tmp = this;
   while (tmp->m_includer != nullptr) {
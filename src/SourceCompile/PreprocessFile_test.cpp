@@ -18,11 +18,15 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <random>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace SURELOG {
+namespace fs = std::filesystem;
 using ::testing::ElementsAre;
 
 namespace {
@@ -34,6 +38,36 @@ bool ContainsError(const ErrorContainer &errors,
       [etype](const Error &e) { return e.getType() == etype; });
 }
 
+// File in the temp directory, under a name no other test process uses,
+// removed when going out of scope
+class TempFile {
+ public:
+  explicit TempFile(std::string_view content) {
+    const ::testing::TestInfo *info =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    std::random_device rd;
+    do {
+      m_path = fs::temp_directory_path() /
+               (std::string("surelog_") + info->name() + "_" +
+                std::to_string(rd()) + ".svh");
+    } while (fs::exists(m_path));
+    std::ofstream ofs(m_path);
+    ofs << content;
+  }
+  ~TempFile() {
+    std::error_code ec;
+    fs::remove(m_path, ec);
+  }
+
+  const fs::path &path() const { return m_path; }
+
+ private:
+  TempFile(const TempFile &) = delete;
+  TempFile &operator=(const TempFile &) = delete;
+
+  fs::path m_path;
+};
+
 TEST(PreprocessTest, PreprocessWithoutPPTokens) {
   PreprocessHarness harness;
   const std::string res = harness.preprocess("module top(); endmodule");
@@ -132,6 +166,37 @@ endmodule)");
                             ErrorDefinition::PP_TOO_MANY_ARGS_MACRO));
 }
 
+TEST(PreprocessTest, RecursiveMacroIsReported) {
+  PreprocessHarness harness;
+  harness.preprocess(R"(
+`define LOOP_A `LOOP_B
+`define LOOP_B `LOOP_A
+module top();
+  assign a = `LOOP_A;
+endmodule)");
+
+  EXPECT_TRUE(ContainsError(harness.collected_errors(),
+                            ErrorDefinition::PP_RECURSIVE_MACRO_DEFINITION));
+}
+
+TEST(PreprocessTest, MacroReachedTwiceIsNotRecursive) {
+  PreprocessHarness harness;
+  const std::string res = harness.preprocess(R"(
+`define LEAF 1
+`define MID `LEAF
+`define TOP (`LEAF + `MID)
+module top();
+  assign a = `TOP + `MID;
+endmodule)");
+
+  EXPECT_FALSE(ContainsError(harness.collected_errors(),
+                             ErrorDefinition::PP_RECURSIVE_MACRO_DEFINITION));
+  EXPECT_EQ(res, R"(
+module top();
+  assign a = (1 + 1) + 1;
+endmodule)");
+}
+
 TEST(PreprocessTest, IfdefCodeSelectionIfBranch) {
   PreprocessHarness harness;
   const std::string res = harness.preprocess(R"(
@@ -176,5 +241,27 @@ module top();
 endmodule)");
 }
 
+// Included files without directives skip the preprocessor grammar, they
+// still open and close design elements for the including file.
+TEST(PreprocessTest, DirectiveFreeIncludeEndsDesignElement) {
+  const TempFile body("  wire a;\nendmodule\n");
+  PreprocessHarness harness;
+  harness.preprocess("module m;\n`include \"" + body.path().string() +
+                     "\"\n`timescale 1ns/1ps\n`resetall\n");
+  EXPECT_FALSE(
+      ContainsError(harness.collected_errors(),
+                    ErrorDefinition::PP_ILLEGAL_DIRECTIVE_IN_DESIGN_ELEMENT));
+}
+
+TEST(PreprocessTest, DirectiveFreeIncludeStartsDesignElement) {
+  const TempFile header("// endmodule in a comment\nmodule m;\n  wire a;\n");
+  PreprocessHarness harness;
+  harness.preprocess("`include \"" + header.path().string() +
+                     "\"\n`timescale 1ns/1ps\nendmodule\n");
+  EXPECT_TRUE(
+      ContainsError(harness.collected_errors(),
+                    ErrorDefinition::PP_ILLEGAL_DIRECTIVE_IN_DESIGN_ELEMENT));
+}
+
 }  // namespace
 }  // namespace SURELOG
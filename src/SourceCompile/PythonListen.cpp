@@ -46,6 +46,7 @@ bool PythonListen::listen() {
   PythonAPICache cache(this);
   if (cache.restore()) {
     m_usingCachedVersion = true;
+    if (m_parse->m_parent == nullptr) m_parse->releaseParserHandler();
     return true;
   }
 
@@ -77,6 +78,8 @@ bool PythonListen::listen() {
         }
       }
     }
+    // The chunks get released with their parent file
+    m_parse->releaseParserHandler();
   }
 
   if (!cache.save()) {
@@ -0,0 +1,866 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <CommonTokenFactory.h>
+#include <Surelog/SourceCompile/SV3_1aFastLexer.h>
+#include <parser/SV3_1aLexer.h>
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+// Fixed-text rules of SV3_1aLexer.g4, in rule definition order
+struct Literal {
+  std::string_view m_text;
+  size_t m_type;
+  bool m_svOnly;  // Guarded by { sverilog }?
+};
+
+static const Literal kLiterals[] = {
+    {"?", SV3_1aLexer::QMARK, false},
+    {"'b0", SV3_1aLexer::TICK_b0, false},
+    {"'b1", SV3_1aLexer::TICK_b1, false},
+    {"'B0", SV3_1aLexer::TICK_B0, false},
+    {"'B1", SV3_1aLexer::TICK_B1, false},
+    {"'0", SV3_1aLexer::TICK_0, false},
+    {"'1", SV3_1aLexer::TICK_1, false},
+    {"1'b0", SV3_1aLexer::ONE_TICK_b0, false},
+    {"1'b1", SV3_1aLexer::ONE_TICK_b1, false},
+    {"1'bx", SV3_1aLexer::ONE_TICK_bx, false},
+    {"1'bX", SV3_1aLexer::ONE_TICK_bX, false},
+    {"1'B0", SV3_1aLexer::ONE_TICK_B0, false},
+    {"1'B1", SV3_1aLexer::ONE_TICK_B1, false},
+    {"1'Bx", SV3_1aLexer::ONE_TICK_Bx, false},
+    {"1'BX", SV3_1aLexer::ONE_TICK_BX, false},
+    {"include", SV3_1aLexer::INCLUDE, false},
+    {"library", SV3_1aLexer::LIBRARY, false},
+    {"-incdir", SV3_1aLexer::INCDIR, false},
+    {",", SV3_1aLexer::COMMA, false},
+    {";", SV3_1aLexer::SEMICOLUMN, false},
+    {"::", SV3_1aLexer::COLUMNCOLUMN, false},
+    {":", SV3_1aLexer::COLUMN, false},
+    {"design", SV3_1aLexer::DESIGN, false},
+    {".", SV3_1aLexer::DOT, false},
+    {"default", SV3_1aLexer::DEFAULT, false},
+    {"instance", SV3_1aLexer::INSTANCE, false},
+    {"cell", SV3_1aLexer::CELL, false},
+    {"liblist", SV3_1aLexer::LIBLIST, false},
+    {"use", SV3_1aLexer::USE, false},
+    {"module", SV3_1aLexer::MODULE, false},
+    {"endmodule", SV3_1aLexer::ENDMODULE, false},
+    {"(", SV3_1aLexer::OPEN_PARENS, false},
+    {")", SV3_1aLexer::CLOSE_PARENS, false},
+    {"*", SV3_1aLexer::STAR, false},
+    {"extern", SV3_1aLexer::EXTERN, false},
+    {"macromodule", SV3_1aLexer::MACROMODULE, false},
+    {"interface", SV3_1aLexer::INTERFACE, false},
+    {"endinterface", SV3_1aLexer::ENDINTERFACE, false},
+    {"program", SV3_1aLexer::PROGRAM, false},
+    {"endprogram", SV3_1aLexer::ENDPROGRAM, false},
+    {"virtual", SV3_1aLexer::VIRTUAL, false},
+    {"class", SV3_1aLexer::CLASS, false},
+    {"endclass", SV3_1aLexer::ENDCLASS, false},
+    {"extends", SV3_1aLexer::EXTENDS, false},
+    {"package", SV3_1aLexer::PACKAGE, false},
+    {"endpackage", SV3_1aLexer::ENDPACKAGE, false},
+    {"timeunit", SV3_1aLexer::TIMEUNIT, false},
+    {"timeprecision", SV3_1aLexer::TIMEPRECISION, false},
+    {"checker", SV3_1aLexer::CHECKER, false},
+    {"endchecker", SV3_1aLexer::ENDCHECKER, false},
+    {"config", SV3_1aLexer::CONFIG, false},
+    {"endconfig", SV3_1aLexer::ENDCONFIG, false},
+    {"type", SV3_1aLexer::TYPE, true},
+    {"untyped", SV3_1aLexer::UNTYPED, false},
+    {"input", SV3_1aLexer::INPUT, false},
+    {"output", SV3_1aLexer::OUTPUT, false},
+    {"inout", SV3_1aLexer::INOUT, false},
+    {"ref", SV3_1aLexer::REF, true},
+    {"clocking", SV3_1aLexer::CLOCKING, false},
+    {"defparam", SV3_1aLexer::DEFPARAM, false},
+    {"bind", SV3_1aLexer::BIND, false},
+    {"forkjoin", SV3_1aLexer::FORKJOIN, false},
+    {"const", SV3_1aLexer::CONST, false},
+    {"function", SV3_1aLexer::FUNCTION, false},
+    {"new", SV3_1aLexer::NEW, true},
+    {"static", SV3_1aLexer::STATIC, false},
+    {"protected", SV3_1aLexer::PROTECTED, false},
+    {"local", SV3_1aLexer::LOCAL, false},
+    {"rand", SV3_1aLexer::RAND, false},
+    {"randc", SV3_1aLexer::RANDC, false},
+    {"super", SV3_1aLexer::SUPER, false},
+    {"endfunction", SV3_1aLexer::ENDFUNCTION, false},
+    {"constraint", SV3_1aLexer::CONSTRAINT, false},
+    {"{", SV3_1aLexer::OPEN_CURLY, false},
+    {"}", SV3_1aLexer::CLOSE_CURLY, false},
+    {"solve", SV3_1aLexer::SOLVE, false},
+    {"before", SV3_1aLexer::BEFORE, false},
+    {"->", SV3_1aLexer::IMPLY, false},
+    {"if", SV3_1aLexer::IF, false},
+    {"else", SV3_1aLexer::ELSE, false},
+    {"foreach", SV3_1aLexer::FOREACH, false},
+    {":=", SV3_1aLexer::ASSIGN_VALUE, false},
+    {"automatic", SV3_1aLexer::AUTOMATIC, false},
+    {"localparam", SV3_1aLexer::LOCALPARAM, false},
+    {"parameter", SV3_1aLexer::PARAMETER, false},
+    {"specparam", SV3_1aLexer::SPECPARAM, false},
+    {"import", SV3_1aLexer::IMPORT, false},
+    {"genvar", SV3_1aLexer::GENVAR, false},
+    {"vectored", SV3_1aLexer::VECTORED, false},
+    {"scalared", SV3_1aLexer::SCALARED, false},
+    {"typedef", SV3_1aLexer::TYPEDEF, false},
+    {"enum", SV3_1aLexer::ENUM, false},
+    {"struct", SV3_1aLexer::STRUCT, false},
+    {"union", SV3_1aLexer::UNION, false},
+    {"packed", SV3_1aLexer::PACKED, false},
+    {"string", SV3_1aLexer::STRING, false},
+    {"chandle", SV3_1aLexer::CHANDLE, false},
+    {"event", SV3_1aLexer::EVENT, false},
+    {"[", SV3_1aLexer::OPEN_BRACKET, false},
+    {"]", SV3_1aLexer::CLOSE_BRACKET, false},
+    {"byte", SV3_1aLexer::BYTE, true},
+    {"shortint", SV3_1aLexer::SHORTINT, false},
+    {"int", SV3_1aLexer::INT, false},
+    {"longint", SV3_1aLexer::LONGINT, false},
+    {"integer", SV3_1aLexer::INTEGER, false},
+    {"time", SV3_1aLexer::TIME, false},
+    {"bit", SV3_1aLexer::BIT, true},
+    {"logic", SV3_1aLexer::LOGIC, true},
+    {"reg", SV3_1aLexer::REG, false},
+    {"shortreal", SV3_1aLexer::SHORTREAL, false},
+    {"real", SV3_1aLexer::REAL, false},
+    {"realtime", SV3_1aLexer::REALTIME, false},
+    {"nexttime", SV3_1aLexer::NEXTTIME, false},
+    {"s_nexttime", SV3_1aLexer::S_NEXTTIME, false},
+    {"s_always", SV3_1aLexer::S_ALWAYS, false},
+    {"until_with", SV3_1aLexer::UNTIL_WITH, false},
+    {"s_until_with", SV3_1aLexer::S_UNTIL_WITH, false},
+    {"accept_on", SV3_1aLexer::ACCEPT_ON, false},
+    {"reject_on", SV3_1aLexer::REJECT_ON, false},
+    {"sync_accept_on", SV3_1aLexer::SYNC_ACCEPT_ON, false},
+    {"sync_reject_on", SV3_1aLexer::SYNC_REJECT_ON, false},
+    {"eventually", SV3_1aLexer::EVENTUALLY, false},
+    {"s_eventually", SV3_1aLexer::S_EVENTUALLY, false},
+    {"supply0", SV3_1aLexer::SUPPLY0, false},
+    {"supply1", SV3_1aLexer::SUPPLY1, false},
+    {"tri", SV3_1aLexer::TRI, false},
+    {"triand", SV3_1aLexer::TRIAND, false},
+    {"trior", SV3_1aLexer::TRIOR, false},
+    {"tri0", SV3_1aLexer::TRI0, false},
+    {"tri1", SV3_1aLexer::TRI1, false},
+    {"wire", SV3_1aLexer::WIRE, false},
+    {"uwire", SV3_1aLexer::UWIRE, false},
+    {"wand", SV3_1aLexer::WAND, false},
+    {"wor", SV3_1aLexer::WOR, false},
+    {"trireg", SV3_1aLexer::TRIREG, false},
+    {"signed", SV3_1aLexer::SIGNED, false},
+    {"unsigned", SV3_1aLexer::UNSIGNED, false},
+    {"interconnect", SV3_1aLexer::INTERCONNECT, false},
+    {"var", SV3_1aLexer::VAR, true},
+    {"void", SV3_1aLexer::VOID, false},
+    {"highz0", SV3_1aLexer::HIGHZ0, false},
+    {"highz1", SV3_1aLexer::HIGHZ1, false},
+    {"strong", SV3_1aLexer::STRONG, false},
+    {"weak", SV3_1aLexer::WEAK, false},
+    {"strong0", SV3_1aLexer::STRONG0, false},
+    {"pull0", SV3_1aLexer::PULL0, false},
+    {"weak0", SV3_1aLexer::WEAK0, false},
+    {"strong1", SV3_1aLexer::STRONG1, false},
+    {"pull1", SV3_1aLexer::PULL1, false},
+    {"weak1", SV3_1aLexer::WEAK1, false},
+    {"(small)", SV3_1aLexer::SMALL, false},
+    {"(medium)", SV3_1aLexer::MEDIUM, false},
+    {"(large)", SV3_1aLexer::LARGE, false},
+    {"PATHPULSE", SV3_1aLexer::PATHPULSE, false},
+    {"$", SV3_1aLexer::DOLLAR, false},
+    {"export", SV3_1aLexer::EXPORT, false},
+    {"context", SV3_1aLexer::CONTEXT, true},
+    {"pure", SV3_1aLexer::PURE, false},
+    {"implements", SV3_1aLexer::IMPLEMENTS, false},
+    {"endtask", SV3_1aLexer::ENDTASK, false},
+    {"++", SV3_1aLexer::PLUSPLUS, false},
+    {"+", SV3_1aLexer::PLUS, false},
+    {"--", SV3_1aLexer::MINUSMINUS, false},
+    {"-", SV3_1aLexer::MINUS, false},
+    {"*::*", SV3_1aLexer::STARCOLUMNCOLUMNSTAR, false},
+    {"**", SV3_1aLexer::STARSTAR, false},
+    {"/", SV3_1aLexer::DIV, false},
+    {"%", SV3_1aLexer::PERCENT, false},
+    {"==", SV3_1aLexer::EQUIV, false},
+    {"!=", SV3_1aLexer::NOTEQUAL, false},
+    {"<", SV3_1aLexer::LESS, false},
+    {"<=", SV3_1aLexer::LESS_EQUAL, false},
+    {">", SV3_1aLexer::GREATER, false},
+    {"<->", SV3_1aLexer::EQUIVALENCE, false},
+    {">=", SV3_1aLexer::GREATER_EQUAL, false},
+    {"modport", SV3_1aLexer::MODPORT, false},
+    {"$unit", SV3_1aLexer::DOLLAR_UNIT, false},
+    {"(*", SV3_1aLexer::OPEN_PARENS_STAR, false},
+    {"*)", SV3_1aLexer::STAR_CLOSE_PARENS, false},
+    {"assert", SV3_1aLexer::ASSERT, false},
+    {"property", SV3_1aLexer::PROPERTY, false},
+    {"assume", SV3_1aLexer::ASSUME, false},
+    {"cover", SV3_1aLexer::COVER, false},
+    {"expect", SV3_1aLexer::EXPECT, true},
+    {"endproperty", SV3_1aLexer::ENDPROPERTY, false},
+    {"disable", SV3_1aLexer::DISABLE, false},
+    {"iff", SV3_1aLexer::IFF, false},
+    {"|->", SV3_1aLexer::OVERLAP_IMPLY, false},
+    {"|=>", SV3_1aLexer::NON_OVERLAP_IMPLY, false},
+    {"not", SV3_1aLexer::NOT, false},
+    {"or", SV3_1aLexer::OR, false},
+    {"and", SV3_1aLexer::AND, false},
+    {"sequence", SV3_1aLexer::SEQUENCE, false},
+    {"endsequence", SV3_1aLexer::ENDSEQUENCE, false},
+    {"intersect", SV3_1aLexer::INTERSECT, false},
+    {"first_match", SV3_1aLexer::FIRST_MATCH, false},
+    {"throughout", SV3_1aLexer::THROUGHOUT, false},
+    {"within", SV3_1aLexer::WITHIN, false},
+    {"##", SV3_1aLexer::POUNDPOUND, false},
+    {"#-#", SV3_1aLexer::OVERLAPPED, false},
+    {"#=#", SV3_1aLexer::NONOVERLAPPED, false},
+    {"#", SV3_1aLexer::POUND, false},
+    {"[*", SV3_1aLexer::CONSECUTIVE_REP, false},
+    {"[=", SV3_1aLexer::NON_CONSECUTIVE_REP, false},
+    {"[->", SV3_1aLexer::GOTO_REP, false},
+    {"dist", SV3_1aLexer::DIST, false},
+    {"covergroup", SV3_1aLexer::COVERGROUP, false},
+    {"endgroup", SV3_1aLexer::ENDGROUP, false},
+    {"option.", SV3_1aLexer::OPTION_DOT, false},
+    {"type_option.", SV3_1aLexer::TYPE_OPTION_DOT, false},
+    {"@@", SV3_1aLexer::ATAT, false},
+    {"begin", SV3_1aLexer::BEGIN, false},
+    {"end", SV3_1aLexer::END, false},
+    {"wildcard", SV3_1aLexer::WILDCARD, false},
+    {"bins", SV3_1aLexer::BINS, false},
+    {"illegal_bins", SV3_1aLexer::ILLEGAL_BINS, false},
+    {"ignore_bins", SV3_1aLexer::IGNORE_BINS, false},
+    {"=>", SV3_1aLexer::TRANSITION_OP, false},
+    {"!", SV3_1aLexer::BANG, false},
+    {"soft", SV3_1aLexer::SOFT, true},
+    {"until", SV3_1aLexer::UNTIL, false},
+    {"s_until", SV3_1aLexer::S_UNTIL, false},
+    {"implies", SV3_1aLexer::IMPLIES, false},
+    {"&&", SV3_1aLexer::LOGICAL_AND, false},
+    {"||", SV3_1aLexer::LOGICAL_OR, false},
+    {"binsof", SV3_1aLexer::BINSOF, false},
+    {"pulldown", SV3_1aLexer::PULLDOWN, false},
+    {"pullup", SV3_1aLexer::PULLUP, false},
+    {"cmos", SV3_1aLexer::CMOS, false},
+    {"rcmos", SV3_1aLexer::RCMOS, false},
+    {"bufif0", SV3_1aLexer::BUFIF0, false},
+    {"bufif1", SV3_1aLexer::BUFIF1, false},
+    {"notif0", SV3_1aLexer::NOTIF0, false},
+    {"notif1", SV3_1aLexer::NOTIF1, false},
+    {"nmos", SV3_1aLexer::NMOS, false},
+    {"pmos", SV3_1aLexer::PMOS, false},
+    {"rnmos", SV3_1aLexer::RNMOS, false},
+    {"rpmos", SV3_1aLexer::RPMOS, false},
+    {"nand", SV3_1aLexer::NAND, false},
+    {"nor", SV3_1aLexer::NOR, false},
+    {"xor", SV3_1aLexer::XOR, false},
+    {"xnor", SV3_1aLexer::XNOR, false},
+    {"buf", SV3_1aLexer::BUF, false},
+    {"tranif0", SV3_1aLexer::TRANIF0, false},
+    {"tranif1", SV3_1aLexer::TRANIF1, false},
+    {"rtranif1", SV3_1aLexer::RTRANIF1, false},
+    {"rtranif0", SV3_1aLexer::RTRANIF0, false},
+    {"tran", SV3_1aLexer::TRAN, false},
+    {"rtran", SV3_1aLexer::RTRAN, false},
+    {".*", SV3_1aLexer::DOTSTAR, false},
+    {"generate", SV3_1aLexer::GENERATE, false},
+    {"endgenerate", SV3_1aLexer::ENDGENERATE, false},
+    {"case", SV3_1aLexer::CASE, false},
+    {"endcase", SV3_1aLexer::ENDCASE, false},
+    {"for", SV3_1aLexer::FOR, false},
+    {"global", SV3_1aLexer::GLOBAL, true},
+    {"primitive", SV3_1aLexer::PRIMITIVE, false},
+    {"endprimitive", SV3_1aLexer::ENDPRIMITIVE, false},
+    {"table", SV3_1aLexer::TABLE, false},
+    {"endtable", SV3_1aLexer::ENDTABLE, false},
+    {"initial", SV3_1aLexer::INITIAL, false},
+    {"assign", SV3_1aLexer::ASSIGN, false},
+    {"alias", SV3_1aLexer::ALIAS, false},
+    {"always", SV3_1aLexer::ALWAYS, false},
+    {"always_comb", SV3_1aLexer::ALWAYS_COMB, false},
+    {"always_latch", SV3_1aLexer::ALWAYS_LATCH, false},
+    {"always_ff", SV3_1aLexer::ALWAYS_FF, false},
+    {"+=", SV3_1aLexer::ADD_ASSIGN, false},
+    {"-=", SV3_1aLexer::SUB_ASSIGN, false},
+    {"*=", SV3_1aLexer::MULT_ASSIGN, false},
+    {"/=", SV3_1aLexer::DIV_ASSIGN, false},
+    {"%=", SV3_1aLexer::MODULO_ASSIGN, false},
+    {"&=", SV3_1aLexer::BITW_AND_ASSIGN, false},
+    {"|=", SV3_1aLexer::BITW_OR_ASSIGN, false},
+    {"^=", SV3_1aLexer::BITW_XOR_ASSIGN, false},
+    {"<<=", SV3_1aLexer::BITW_LEFT_SHIFT_ASSIGN, false},
+    {">>=", SV3_1aLexer::BITW_RIGHT_SHIFT_ASSIGN, false},
+    {"deassign", SV3_1aLexer::DEASSIGN, false},
+    {"force", SV3_1aLexer::FORCE, false},
+    {"release", SV3_1aLexer::RELEASE, false},
+    {"fork", SV3_1aLexer::FORK, false},
+    {"join", SV3_1aLexer::JOIN, false},
+    {"join_any", SV3_1aLexer::JOIN_ANY, false},
+    {"join_none", SV3_1aLexer::JOIN_NONE, false},
+    {"repeat", SV3_1aLexer::REPEAT, false},
+    {"@", SV3_1aLexer::AT, false},
+    {"return", SV3_1aLexer::RETURN, false},
+    {"break", SV3_1aLexer::BREAK, false},
+    {"continue", SV3_1aLexer::CONTINUE, false},
+    {"wait", SV3_1aLexer::WAIT, false},
+    {"wait_order", SV3_1aLexer::WAIT_ORDER, false},
+    {"unique", SV3_1aLexer::UNIQUE, false},
+    {"unique0", SV3_1aLexer::UNIQUE0, false},
+    {"priority", SV3_1aLexer::PRIORITY, false},
+    {"matches", SV3_1aLexer::MATCHES, false},
+    {"casez", SV3_1aLexer::CASEZ, false},
+    {"casex", SV3_1aLexer::CASEX, false},
+    {"randcase", SV3_1aLexer::RANDCASE, false},
+    {"tagged", SV3_1aLexer::TAGGED, false},
+    {"forever", SV3_1aLexer::FOREVER, false},
+    {"while", SV3_1aLexer::WHILE, false},
+    {"do", SV3_1aLexer::DO, true},
+    {"restrict", SV3_1aLexer::RESTRICT, false},
+    {"let", SV3_1aLexer::LET, false},
+    {"'", SV3_1aLexer::TICK, false},
+    {"endclocking", SV3_1aLexer::ENDCLOCKING, false},
+    {"randsequence", SV3_1aLexer::RANDSEQUENCE, false},
+    {">>", SV3_1aLexer::SHIFT_RIGHT, false},
+    {"<<", SV3_1aLexer::SHIFT_LEFT, false},
+    {"with", SV3_1aLexer::WITH, false},
+    {"+:", SV3_1aLexer::INC_PART_SELECT_OP, false},
+    {"-:", SV3_1aLexer::DEC_PART_SELECT_OP, false},
+    {"inside", SV3_1aLexer::INSIDE, false},
+    {"null", SV3_1aLexer::NULL_KEYWORD, false},
+    {"this", SV3_1aLexer::THIS, true},
+    {"$root", SV3_1aLexer::DOLLAR_ROOT, false},
+    {"randomize", SV3_1aLexer::RANDOMIZE, true},
+    {"final", SV3_1aLexer::FINAL, true},
+    {"task", SV3_1aLexer::TASK, false},
+    {"coverpoint", SV3_1aLexer::COVERPOINT, false},
+    {"cross", SV3_1aLexer::CROSS, false},
+    {"posedge", SV3_1aLexer::POSEDGE, false},
+    {"negedge", SV3_1aLexer::NEGEDGE, false},
+    {"specify", SV3_1aLexer::SPECIFY, false},
+    {"endspecify", SV3_1aLexer::ENDSPECIFY, false},
+    {"pulsestyle_onevent", SV3_1aLexer::PULSESTYLE_ONEVENT, false},
+    {"pulsestyle_ondetect", SV3_1aLexer::PULSESTYLE_ONDETECT, false},
+    {"showcancelled", SV3_1aLexer::SHOWCANCELLED, false},
+    {"noshowcancelled", SV3_1aLexer::NOSHOWCANCELLED, false},
+    {"ifnone", SV3_1aLexer::IFNONE, false},
+    {"sample", SV3_1aLexer::SAMPLE, true},
+    {"edge", SV3_1aLexer::EDGE, false},
+    {"->>", SV3_1aLexer::NON_BLOCKING_TRIGGER_EVENT_OP, false},
+    {">>>", SV3_1aLexer::ARITH_SHIFT_RIGHT, false},
+    {"<<<", SV3_1aLexer::ARITH_SHIFT_LEFT, false},
+    {"<<<=", SV3_1aLexer::ARITH_SHIFT_LEFT_ASSIGN, false},
+    {">>>=", SV3_1aLexer::ARITH_SHIFT_RIGHT_ASSIGN, false},
+    {"===", SV3_1aLexer::FOUR_STATE_LOGIC_EQUAL, false},
+    {"!==", SV3_1aLexer::FOUR_STATE_LOGIC_NOTEQUAL, false},
+    {"==?", SV3_1aLexer::BINARY_WILDCARD_EQUAL, false},
+    {"!=?", SV3_1aLexer::BINARY_WILDCARD_NOTEQUAL, false},
+    {"*>", SV3_1aLexer::FULL_CONN_OP, false},
+    {"&&&", SV3_1aLexer::COND_PRED_OP, false},
+    {"&", SV3_1aLexer::BITW_AND, false},
+    {"|", SV3_1aLexer::BITW_OR, false},
+    {"~|", SV3_1aLexer::REDUCTION_NOR, false},
+    {"~&", SV3_1aLexer::REDUCTION_NAND, false},
+    {"^~", SV3_1aLexer::REDUCTION_XNOR1, false},
+    {"=?=", SV3_1aLexer::WILD_EQUAL_OP, false},
+    {"!?=", SV3_1aLexer::WILD_NOTEQUAL_OP, false},
+    {"=", SV3_1aLexer::ASSIGN_OP, false},
+    {"nettype", SV3_1aLexer::NETTYPE, false},
+    {"~", SV3_1aLexer::TILDA, false},
+    {"^", SV3_1aLexer::BITW_XOR, false},
+    {"~^", SV3_1aLexer::REDUCTION_XNOR2, false},
+    {"`line", SV3_1aLexer::TICK_LINE, false},
+    {"`timescale", SV3_1aLexer::TICK_TIMESCALE, false},
+    {"`begin_keywords", SV3_1aLexer::TICK_BEGIN_KEYWORDS, false},
+    {"`end_keywords", SV3_1aLexer::TICK_END_KEYWORDS, false},
+    {"`unconnected_drive", SV3_1aLexer::TICK_UNCONNECTED_DRIVE, false},
+    {"`nounconnected_drive", SV3_1aLexer::TICK_NOUNCONNECTED_DRIVE, false},
+    {"`celldefine", SV3_1aLexer::TICK_CELLDEFINE, false},
+    {"`endcelldefine", SV3_1aLexer::TICK_ENDCELLDEFINE, false},
+    {"`default_nettype", SV3_1aLexer::TICK_DEFAULT_NETTYPE, false},
+    {"`default_decay_time", SV3_1aLexer::TICK_DEFAULT_DECAY_TIME, false},
+    {"`default_trireg_strength", SV3_1aLexer::TICK_DEFAULT_TRIREG_STRENGTH,
+     false},
+    {"`delay_mode_distributed", SV3_1aLexer::TICK_DELAY_MODE_DISTRIBUTED,
+     false},
+    {"`delay_mode_path", SV3_1aLexer::TICK_DELAY_MODE_PATH, false},
+    {"`delay_mode_unit", SV3_1aLexer::TICK_DELAY_MODE_UNIT, false},
+    {"`delay_mode_zero", SV3_1aLexer::TICK_DELAY_MODE_ZERO, false},
+    {"`accelerate", SV3_1aLexer::TICK_ACCELERATE, false},
+    {"`noaccelerate", SV3_1aLexer::TICK_NOACCELERATE, false},
+    {"`protect", SV3_1aLexer::TICK_PROTECT, false},
+    {"`disable_portfaults", SV3_1aLexer::TICK_DISABLE_PORTFAULTS, false},
+    {"`enable_portfaults", SV3_1aLexer::TICK_ENABLE_PORTFAULTS, false},
+    {"`nosuppress_faults", SV3_1aLexer::TICK_NOSUPPRESS_FAULTS, false},
+    {"`suppress_faults", SV3_1aLexer::TICK_SUPPRESS_FAULTS, false},
+    {"`signed", SV3_1aLexer::TICK_SIGNED, false},
+    {"`unsigned", SV3_1aLexer::TICK_UNSIGNED, false},
+    {"`endprotect", SV3_1aLexer::TICK_ENDPROTECT, false},
+    {"`protected", SV3_1aLexer::TICK_PROTECTED, false},
+    {"`endprotected", SV3_1aLexer::TICK_ENDPROTECTED, false},
+    {"`expand_vectornets", SV3_1aLexer::TICK_EXPAND_VECTORNETS, false},
+    {"`noexpand_vectornets", SV3_1aLexer::TICK_NOEXPAND_VECTORNETS, false},
+    {"`autoexpand_vectornets", SV3_1aLexer::TICK_AUTOEXPAND_VECTORNETS, false},
+    {"`remove_gatename", SV3_1aLexer::TICK_REMOVE_GATENAME, false},
+    {"`noremove_gatenames", SV3_1aLexer::TICK_NOREMOVE_GATENAMES, false},
+    {"`remove_netname", SV3_1aLexer::TICK_REMOVE_NETNAME, false},
+    {"`noremove_netnames", SV3_1aLexer::TICK_NOREMOVE_NETNAMES, false},
+    {"1step", SV3_1aLexer::ONESTEP, false},
+    {"`uselib", SV3_1aLexer::TICK_USELIB, false},
+    {"`pragma", SV3_1aLexer::TICK_PRAGMA, false},
+    {"`", SV3_1aLexer::BACK_TICK, false},
+};
+
+constexpr bool isIdentifierStart(char c) {
+  return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+         (c == '_');
+}
+
+constexpr bool isIdentifierPart(char c) {
+  return isIdentifierStart(c) || ((c >= '0') && (c <= '9')) || (c == '$');
+}
+
+constexpr bool isDigit(char c) { return (c >= '0') && (c <= '9'); }
+
+constexpr bool isWhiteSpace(char c) {
+  return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+// Literal lookup tables: literals that look like identifiers (keywords) are
+// found by exact match on the scanned identifier, a keyword shorter than the
+// identifier never wins. All others are tried by first character, longest
+// first.
+struct LiteralTables {
+  LiteralTables() {
+    for (const Literal& literal : kLiterals) {
+      bool keyword = isIdentifierStart(literal.m_text.front());
+      for (char c : literal.m_text) keyword = keyword && isIdentifierPart(c);
+      if (keyword) {
+        m_keywords.emplace(literal.m_text, &literal);
+      } else {
+        m_byFirstChar[(unsigned char)literal.m_text.front()].push_back(
+            &literal);
+      }
+    }
+    for (std::vector<const Literal*>& literals : m_byFirstChar) {
+      std::stable_sort(literals.begin(), literals.end(),
+                       [](const Literal* lhs, const Literal* rhs) {
+                         return lhs->m_text.size() > rhs->m_text.size();
+                       });
+    }
+  }
+
+  std::unordered_map<std::string_view, const Literal*> m_keywords;
+  std::array<std::vector<const Literal*>, 256> m_byFirstChar;
+};
+
+const LiteralTables& literalTables() {
+  static const LiteralTables tables;
+  return tables;
+}
+
+// Longest token candidate, ties go to the rule defined first (lowest type)
+class Candidate {
+ public:
+  void consider(size_t length, size_t type) {
+    if ((length > m_length) || ((length == m_length) && (type < m_type))) {
+      m_length = length;
+      m_type = type;
+    }
+  }
+  size_t m_length = 0;
+  size_t m_type = 0;
+};
+
+// Length of the run of characters satisfying "pred" starting at "pos"
+template <typename Predicate>
+size_t scan(std::string_view text, size_t pos, Predicate pred) {
+  size_t end = pos;
+  while ((end < text.size()) && pred(text[end])) ++end;
+  return end - pos;
+}
+
+// Unsigned_number : Decimal_digit ( '_' | Decimal_digit )*
+size_t scanUnsigned(std::string_view text, size_t pos) {
+  if ((pos >= text.size()) || !isDigit(text[pos])) return 0;
+  return 1 + scan(text, pos + 1,
+                  [](char c) { return isDigit(c) || (c == '_'); });
+}
+
+// Binary_value, Octal_value, Hex_value : ('_')* Digit ( '_' | Digit )*
+template <typename Predicate>
+size_t scanBasedValue(std::string_view text, size_t pos, Predicate isDigitOf) {
+  const size_t underscores = scan(text, pos, [](char c) { return c == '_'; });
+  if (((pos + underscores) >= text.size()) ||
+      !isDigitOf(text[pos + underscores])) {
+    return 0;
+  }
+  return underscores +
+         scan(text, pos + underscores,
+              [&isDigitOf](char c) { return isDigitOf(c) || (c == '_'); });
+}
+
+constexpr bool isXZDigit(char c) {
+  return (c == 'x') || (c == 'X') || (c == 'z') || (c == 'Z') || (c == '?');
+}
+
+// Base and value of a based number, starting at the tick
+size_t scanBasedNumber(std::string_view text, size_t pos) {
+  if ((pos >= text.size()) || (text[pos] != '\'')) return 0;
+  size_t end = pos + 1;
+  if ((end < text.size()) && ((text[end] == 's') || (text[end] == 'S'))) ++end;
+  if (end >= text.size()) return 0;
+  const char base = text[end++];
+  end += scan(text, end, [](char c) { return c == ' '; });
+  size_t value = 0;
+  switch (base) {
+    case 'd':
+    case 'D':
+      value = scanUnsigned(text, end);
+      if ((value == 0) && (end < text.size()) && isXZDigit(text[end])) {
+        value = 1 + scan(text, end + 1, [](char c) { return c == '_'; });
+      }
+      break;
+    case 'b':
+    case 'B':
+      value = scanBasedValue(text, end, [](char c) {
+        return isXZDigit(c) || (c == '0') || (c == '1');
+      });
+      break;
+    case 'o':
+    case 'O':
+      value = scanBasedValue(text, end, [](char c) {
+        return isXZDigit(c) || ((c >= '0') && (c <= '7'));
+      });
+      break;
+    case 'h':
+    case 'H':
+      value = scanBasedValue(text, end, [](char c) {
+        return isXZDigit(c) || isDigit(c) || ((c >= 'a') && (c <= 'f')) ||
+               ((c >= 'A') && (c <= 'F'));
+      });
+      break;
+    default:
+      break;
+  }
+  return (value == 0) ? 0 : (end + value - pos);
+}
+
+// Integral_number
+size_t scanIntegralNumber(std::string_view text, size_t pos) {
+  const size_t unsignedLength = scanUnsigned(text, pos);
+  size_t basePos = pos;
+  if (unsignedLength != 0) {
+    // Optional size: Non_zero_unsigned_number ' '*
+    if (text[pos] == '0') return unsignedLength;
+    basePos += unsignedLength;
+    basePos += scan(text, basePos, [](char c) { return c == ' '; });
+  }
+  const size_t based = scanBasedNumber(text, basePos);
+  return (based == 0) ? unsignedLength : (basePos + based - pos);
+}
+
+// Real_number
+size_t scanRealNumber(std::string_view text, size_t pos) {
+  const size_t unsignedLength = scanUnsigned(text, pos);
+  if (unsignedLength == 0) return 0;
+  size_t end = pos + unsignedLength;
+  size_t length = 0;
+  if ((end < text.size()) && (text[end] == '.')) {
+    const size_t fraction = scanUnsigned(text, end + 1);
+    if (fraction == 0) return 0;
+    end += 1 + fraction;
+    length = end - pos;
+  }
+  if ((end < text.size()) && ((text[end] == 'e') || (text[end] == 'E'))) {
+    size_t exponent = end + 1;
+    if ((exponent < text.size()) &&
+        ((text[exponent] == '+') || (text[exponent] == '-'))) {
+      ++exponent;
+    }
+    const size_t digits = scanUnsigned(text, exponent);
+    if (digits != 0) length = exponent + digits - pos;
+  }
+  return length;
+}
+
+// Pound_delay, Pound_Pound_delay : '#' (' ')* [0-9] [0-9_.]*
+size_t scanPoundDelay(std::string_view text, size_t pos) {
+  size_t end = pos + scan(text, pos, [](char c) { return c == ' '; });
+  if ((end >= text.size()) || !isDigit(text[end])) return 0;
+  end += 1 + scan(text, end + 1, [](char c) {
+           return isDigit(c) || (c == '_') || (c == '.');
+         });
+  return end - pos;
+}
+
+// String : '"' ( '\\' ~'\r' | ~('\\' | '"' | '\r' | '\n') )* '"'
+size_t scanString(std::string_view text, size_t pos) {
+  size_t end = pos + 1;
+  while (end < text.size()) {
+    const char c = text[end];
+    if (c == '"') return end + 1 - pos;
+    if (c == '\\') {
+      if (((end + 1) >= text.size()) || (text[end + 1] == '\r')) return 0;
+      end += 2;
+    } else if ((c == '\r') || (c == '\n')) {
+      return 0;
+    } else {
+      ++end;
+    }
+  }
+  return 0;
+}
+
+// Length of "start" .*? "stop", 0 if "stop" is never found
+size_t scanDelimited(std::string_view text, size_t pos, std::string_view start,
+                     std::string_view stop) {
+  const size_t end = text.find(stop, pos + start.size());
+  return (end == std::string_view::npos) ? 0 : (end + stop.size() - pos);
+}
+}  // namespace
+
+SV3_1aFastLexer::Token::Token(SV3_1aFastLexer* source, size_t type,
+                              size_t channel, size_t start, size_t length,
+                              size_t line, size_t column)
+    : m_source(source),
+      m_start(start),
+      m_length(length),
+      m_line(line),
+      m_column(column),
+      m_index(INVALID_INDEX),
+      m_type(static_cast<uint32_t>(type)),
+      m_channel(channel) {}
+
+std::string SV3_1aFastLexer::Token::getText() const {
+  if (m_text) return *m_text;
+  if (getType() == EOF) return "<EOF>";
+  return std::string(m_source->getText(m_start, m_length));
+}
+
+size_t SV3_1aFastLexer::Token::getType() const {
+  // Token types are small, EOF is the only one that does not fit
+  return (m_type == static_cast<uint32_t>(EOF)) ? EOF : m_type;
+}
+
+void SV3_1aFastLexer::Token::setType(size_t ttype) {
+  m_type = static_cast<uint32_t>(ttype);
+}
+
+void SV3_1aFastLexer::Token::setText(const std::string& text) {
+  m_text = std::make_unique<std::string>(text);
+}
+
+std::string SV3_1aFastLexer::Token::toString() const {
+  std::string text = getText();
+  std::string escaped;
+  for (char c : text) {
+    switch (c) {
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\r':
+        escaped += "\\r";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      default:
+        escaped += c;
+        break;
+    }
+  }
+  const std::string channel =
+      (m_channel > 0) ? (",channel=" + std::to_string(m_channel)) : "";
+  return "[@" + std::to_string((int64_t)getTokenIndex()) + "," +
+         std::to_string((int64_t)getStartIndex()) + ":" +
+         std::to_string((int64_t)getStopIndex()) + "='" + escaped + "',<" +
+         std::to_string((int64_t)getType()) + ">" + channel + "," +
+         std::to_string(m_line) + ":" + std::to_string(m_column) + "]";
+}
+
+SV3_1aFastLexer::SV3_1aFastLexer(std::string text, std::string_view sourceName)
+    : m_text(std::move(text)), m_sourceName(sourceName) {}
+
+antlr4::TokenFactory<antlr4::CommonToken>* SV3_1aFastLexer::getTokenFactory() {
+  // Only used by the error recovery to conjure missing tokens
+  return antlr4::CommonTokenFactory::DEFAULT.get();
+}
+
+size_t SV3_1aFastLexer::match_(size_t& length) const {
+  const std::string_view text(m_text);
+  const size_t pos = m_offset;
+  const char c = text[pos];
+
+  if (isWhiteSpace(c)) {
+    length = scan(text, pos, isWhiteSpace);
+    return SV3_1aLexer::White_space;
+  }
+
+  Candidate best;
+  const LiteralTables& tables = literalTables();
+  if (isIdentifierStart(c)) {
+    const size_t identifier = scan(text, pos, isIdentifierPart);
+    best.consider(identifier, SV3_1aLexer::Simple_identifier);
+    auto itr = tables.m_keywords.find(text.substr(pos, identifier));
+    if ((itr != tables.m_keywords.end()) &&
+        (sverilog || !itr->second->m_svOnly)) {
+      best.consider(identifier, itr->second->m_type);
+    }
+    // SURELOG_MACRO_NOT_DEFINED : 'SURELOG_MACRO_NOT_DEFINED:'
+    //                             Simple_identifier '!!!'
+    constexpr std::string_view kMacroNotDefined = "SURELOG_MACRO_NOT_DEFINED:";
+    if (text.compare(pos, kMacroNotDefined.size(), kMacroNotDefined) == 0) {
+      const size_t name = pos + kMacroNotDefined.size();
+      if ((name < text.size()) && isIdentifierStart(text[name])) {
+        const size_t end = name + scan(text, name, isIdentifierPart);
+        if (text.compare(end, 3, "!!!") == 0) {
+          best.consider(end + 3 - pos, SV3_1aLexer::SURELOG_MACRO_NOT_DEFINED);
+        }
+      }
+    }
+  }
+
+  for (const Literal* literal : tables.m_byFirstChar[(unsigned char)c]) {
+    if (literal->m_text.size() < best.m_length) break;
+    if ((sverilog || !literal->m_svOnly) &&
+        (text.compare(pos, literal->m_text.size(), literal->m_text) == 0)) {
+      best.consider(literal->m_text.size(), literal->m_type);
+    }
+  }
+
+  switch (c) {
+    case '#':
+      if (text.compare(pos, 2, "##") == 0) {
+        if (size_t delay = scanPoundDelay(text, pos + 2)) {
+          best.consider(2 + delay, SV3_1aLexer::Pound_Pound_delay);
+        }
+      }
+      if (size_t delay = scanPoundDelay(text, pos + 1)) {
+        best.consider(1 + delay, SV3_1aLexer::Pound_delay);
+      }
+      if (text.compare(pos, 3, "#~@") == 0) {
+        best.consider(scanDelimited(text, pos, "#~@", "#~@"),
+                      SV3_1aLexer::Escaped_identifier);
+      }
+      break;
+    case '@':
+      // ATSTAR : '@' ' '? '*'
+      // AT_PARENS_STAR : '@' ' '? '(' ' '? '*' ' '? ')'
+      {
+        size_t end = pos + 1;
+        if ((end < text.size()) && (text[end] == ' ')) ++end;
+        if ((end < text.size()) && (text[end] == '*')) {
+          best.consider(end + 1 - pos, SV3_1aLexer::ATSTAR);
+        } else if ((end < text.size()) && (text[end] == '(')) {
+          ++end;
+          if ((end < text.size()) && (text[end] == ' ')) ++end;
+          if ((end < text.size()) && (text[end] == '*')) {
+            ++end;
+            if ((end < text.size()) && (text[end] == ' ')) ++end;
+            if ((end < text.size()) && (text[end] == ')')) {
+              best.consider(end + 1 - pos, SV3_1aLexer::AT_PARENS_STAR);
+            }
+          }
+        }
+      }
+      break;
+    case '[':
+      // ASSOCIATIVE_UNSPECIFIED : '[' [ ]* '*' [ ]* ']'
+      {
+        size_t end = pos + 1;
+        end += scan(text, end, [](char c) { return c == ' '; });
+        if ((end < text.size()) && (text[end] == '*')) {
+          ++end;
+          end += scan(text, end, [](char c) { return c == ' '; });
+          if ((end < text.size()) && (text[end] == ']')) {
+            best.consider(end + 1 - pos, SV3_1aLexer::ASSOCIATIVE_UNSPECIFIED);
+          }
+        }
+      }
+      break;
+    case '"':
+      best.consider(scanString(text, pos), SV3_1aLexer::String);
+      break;
+    case '/':
+      if (text.compare(pos, 2, "//") == 0) {
+        // One_line_comment : '//' Comment_text '\r'? ('\n' | EOF)
+        const size_t end = text.find('\n', pos + 2);
+        best.consider(
+            (end == std::string_view::npos) ? (text.size() - pos)
+                                            : (end + 1 - pos),
+            SV3_1aLexer::One_line_comment);
+      } else if (text.compare(pos, 2, "/*") == 0) {
+        best.consider(scanDelimited(text, pos, "/*", "*/"),
+                      SV3_1aLexer::Block_comment);
+      }
+      break;
+    case '\'':
+      best.consider(scanIntegralNumber(text, pos),
+                    SV3_1aLexer::Integral_number);
+      break;
+    default:
+      if (isDigit(c)) {
+        best.consider(scanIntegralNumber(text, pos),
+                      SV3_1aLexer::Integral_number);
+        best.consider(scanRealNumber(text, pos), SV3_1aLexer::Real_number);
+      }
+      break;
+  }
+
+  best.consider(1, SV3_1aLexer::ANY);
+  length = best.m_length;
+  return best.m_type;
+}
+
+std::unique_ptr<antlr4::Token> SV3_1aFastLexer::nextToken() {
+  if (m_offset >= m_text.size()) {
+    return std::make_unique<Token>(this, antlr4::Token::EOF,
+                                   antlr4::Token::DEFAULT_CHANNEL,
+                                   m_text.size(), 0, m_line, m_column);
+  }
+
+  size_t length = 0;
+  const size_t type = match_(length);
+  size_t channel = antlr4::Token::DEFAULT_CHANNEL;
+  if (type == SV3_1aLexer::White_space) {
+    channel = SV3_1aLexer::WHITESPACES;
+  } else if ((type == SV3_1aLexer::One_line_comment) ||
+             (type == SV3_1aLexer::Block_comment)) {
+    channel = SV3_1aLexer::COMMENTS;
+  }
+  auto token = std::make_unique<Token>(this, type, channel, m_offset, length,
+                                       m_line, m_column);
+  const size_t end = m_offset + length;
+  for (; m_offset < end; ++m_offset) {
+    if (m_text[m_offset] == '\n') {
+      ++m_line;
+      m_column = 0;
+    } else {
+      ++m_column;
+    }
+  }
+  return token;
+}
+
+}  // namespace SURELOG
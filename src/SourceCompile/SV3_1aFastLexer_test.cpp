@@ -0,0 +1,294 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/SV3_1aFastLexer.h>
+#include <Surelog/Utils/FileUtils.h>
+#include <antlr4-runtime.h>
+#include <gtest/gtest.h>
+#include <parser/SV3_1aLexer.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SURELOG {
+
+namespace {
+using TypeAndText = std::pair<size_t, std::string>;
+
+// Type and text of the default channel tokens, EOF excluded.
+std::vector<TypeAndText> lex(std::string_view text, bool sverilog = true) {
+  SV3_1aFastLexer lexer(std::string(text), "test.sv");
+  lexer.sverilog = sverilog;
+  std::vector<TypeAndText> result;
+  for (auto token = lexer.nextToken(); token->getType() != antlr4::Token::EOF;
+       token = lexer.nextToken()) {
+    if (token->getChannel() == antlr4::Token::DEFAULT_CHANNEL) {
+      result.emplace_back(token->getType(), token->getText());
+    }
+  }
+  return result;
+}
+
+// Compares the complete token stream with the one of the generated lexer.
+void expectSameTokens(const std::string& text, bool sverilog,
+                      const std::string& name) {
+  antlr4::ANTLRInputStream input(text);
+  SV3_1aLexer reference(&input);
+  reference.sverilog = sverilog;
+  reference.removeErrorListeners();
+  SV3_1aFastLexer lexer(text, name);
+  lexer.sverilog = sverilog;
+  while (true) {
+    std::unique_ptr<antlr4::Token> expected = reference.nextToken();
+    std::unique_ptr<antlr4::Token> actual = lexer.nextToken();
+    ASSERT_EQ(actual->getType(), expected->getType())
+        << name << " " << expected->toString();
+    ASSERT_EQ(actual->getText(), expected->getText())
+        << name << " " << expected->toString();
+    ASSERT_EQ(actual->getChannel(), expected->getChannel()) << name;
+    ASSERT_EQ(actual->getLine(), expected->getLine()) << name;
+    ASSERT_EQ(actual->getCharPositionInLine(),
+              expected->getCharPositionInLine())
+        << name;
+    ASSERT_EQ(actual->getStartIndex(), expected->getStartIndex()) << name;
+    ASSERT_EQ(actual->getStopIndex(), expected->getStopIndex()) << name;
+    if (expected->getType() == antlr4::Token::EOF) break;
+  }
+}
+
+TEST(SV3_1aFastLexerTest, KeywordsAndIdentifiers) {
+  EXPECT_EQ(lex("module top; endmodule"),
+            (std::vector<TypeAndText>{{SV3_1aLexer::MODULE, "module"},
+                                      {SV3_1aLexer::Simple_identifier, "top"},
+                                      {SV3_1aLexer::SEMICOLUMN, ";"},
+                                      {SV3_1aLexer::ENDMODULE, "endmodule"}}));
+  EXPECT_EQ(lex("modules option.x type_option.y"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::Simple_identifier, "modules"},
+                {SV3_1aLexer::OPTION_DOT, "option."},
+                {SV3_1aLexer::Simple_identifier, "x"},
+                {SV3_1aLexer::TYPE_OPTION_DOT, "type_option."},
+                {SV3_1aLexer::Simple_identifier, "y"}}));
+  EXPECT_EQ(lex("$unit $root $display a$b"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::DOLLAR_UNIT, "$unit"},
+                {SV3_1aLexer::DOLLAR_ROOT, "$root"},
+                {SV3_1aLexer::DOLLAR, "$"},
+                {SV3_1aLexer::Simple_identifier, "display"},
+                {SV3_1aLexer::Simple_identifier, "a$b"}}));
+  EXPECT_EQ(lex("`timescale `foo SURELOG_MACRO_NOT_DEFINED:bar!!!"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::TICK_TIMESCALE, "`timescale"},
+                {SV3_1aLexer::BACK_TICK, "`"},
+                {SV3_1aLexer::Simple_identifier, "foo"},
+                {SV3_1aLexer::SURELOG_MACRO_NOT_DEFINED,
+                 "SURELOG_MACRO_NOT_DEFINED:bar!!!"}}));
+}
+
+TEST(SV3_1aFastLexerTest, SystemVerilogKeywords) {
+  EXPECT_EQ(lex("logic bit", true),
+            (std::vector<TypeAndText>{{SV3_1aLexer::LOGIC, "logic"},
+                                      {SV3_1aLexer::BIT, "bit"}}));
+  EXPECT_EQ(lex("logic bit", false),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::Simple_identifier, "logic"},
+                {SV3_1aLexer::Simple_identifier, "bit"}}));
+  // Not guarded by the sverilog flag
+  EXPECT_EQ(lex("interface", false),
+            (std::vector<TypeAndText>{{SV3_1aLexer::INTERFACE, "interface"}}));
+}
+
+TEST(SV3_1aFastLexerTest, Numbers) {
+  EXPECT_EQ(lex("1'b0 1'b01 'b1 'b10 8 'hFF 4'sd3 'dx_ 12_3"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::ONE_TICK_b0, "1'b0"},
+                {SV3_1aLexer::Integral_number, "1'b01"},
+                {SV3_1aLexer::TICK_b1, "'b1"},
+                {SV3_1aLexer::Integral_number, "'b10"},
+                {SV3_1aLexer::Integral_number, "8 'hFF"},
+                {SV3_1aLexer::Integral_number, "4'sd3"},
+                {SV3_1aLexer::Integral_number, "'dx_"},
+                {SV3_1aLexer::Integral_number, "12_3"}}));
+  EXPECT_EQ(lex("1.5 1e-3 2.0E4 1. 1step 8'h"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::Real_number, "1.5"},
+                {SV3_1aLexer::Real_number, "1e-3"},
+                {SV3_1aLexer::Real_number, "2.0E4"},
+                {SV3_1aLexer::Integral_number, "1"},
+                {SV3_1aLexer::DOT, "."},
+                {SV3_1aLexer::ONESTEP, "1step"},
+                {SV3_1aLexer::Integral_number, "8"},
+                {SV3_1aLexer::TICK, "'"},
+                {SV3_1aLexer::Simple_identifier, "h"}}));
+  EXPECT_EQ(lex("#10 ## 2 ##"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::Pound_delay, "#10"},
+                {SV3_1aLexer::Pound_Pound_delay, "## 2"},
+                {SV3_1aLexer::POUNDPOUND, "##"}}));
+}
+
+TEST(SV3_1aFastLexerTest, Operators) {
+  EXPECT_EQ(lex("<<<= !== ==? |-> @(*) @ * [ * ] [* a"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::ARITH_SHIFT_LEFT_ASSIGN, "<<<="},
+                {SV3_1aLexer::FOUR_STATE_LOGIC_NOTEQUAL, "!=="},
+                {SV3_1aLexer::BINARY_WILDCARD_EQUAL, "==?"},
+                {SV3_1aLexer::OVERLAP_IMPLY, "|->"},
+                {SV3_1aLexer::AT_PARENS_STAR, "@(*)"},
+                {SV3_1aLexer::ATSTAR, "@ *"},
+                {SV3_1aLexer::ASSOCIATIVE_UNSPECIFIED, "[ * ]"},
+                {SV3_1aLexer::CONSECUTIVE_REP, "[*"},
+                {SV3_1aLexer::Simple_identifier, "a"}}));
+}
+
+TEST(SV3_1aFastLexerTest, StringsCommentsAndEscapedIdentifiers) {
+  EXPECT_EQ(lex("\"a\\\"b\" \"open\n#~@a+b#~@ #~@x"),
+            (std::vector<TypeAndText>{
+                {SV3_1aLexer::String, "\"a\\\"b\""},
+                {SV3_1aLexer::ANY, "\""},
+                {SV3_1aLexer::Simple_identifier, "open"},
+                {SV3_1aLexer::Escaped_identifier, "#~@a+b#~@"},
+                {SV3_1aLexer::POUND, "#"},
+                {SV3_1aLexer::TILDA, "~"},
+                {SV3_1aLexer::AT, "@"},
+                {SV3_1aLexer::Simple_identifier, "x"}}));
+  SV3_1aFastLexer lexer("a // c\n/* b\n */ /", "test.sv");
+  std::vector<std::tuple<size_t, size_t, size_t>> tokens;
+  for (auto token = lexer.nextToken(); token->getType() != antlr4::Token::EOF;
+       token = lexer.nextToken()) {
+    tokens.emplace_back(token->getChannel(), token->getLine(),
+                        token->getCharPositionInLine());
+  }
+  EXPECT_EQ(tokens, (std::vector<std::tuple<size_t, size_t, size_t>>{
+                        {antlr4::Token::DEFAULT_CHANNEL, 1, 0},
+                        {SV3_1aLexer::WHITESPACES, 1, 1},
+                        {SV3_1aLexer::COMMENTS, 1, 2},
+                        {SV3_1aLexer::COMMENTS, 2, 0},
+                        {SV3_1aLexer::WHITESPACES, 3, 3},
+                        {antlr4::Token::DEFAULT_CHANNEL, 3, 4}}));
+}
+
+TEST(SV3_1aFastLexerTest, SameTokensAsGeneratedLexer) {
+  const std::vector<std::string> snippets = {
+      "module top #(parameter P = 8'hFF) (input logic [P-1:0] a);\n"
+      "  always_ff @(posedge clk) b <= #1 a ** 2;\n"
+      "  assert property (@(posedge clk) a |-> ##[1:$] b);\n"
+      "endmodule\n",
+      "class C extends B; rand bit [3:0] x; constraint c { x inside {[1:3]}; }"
+      " function new(); super.new(); endfunction endclass",
+      "`timescale 1ns/1ps\n real r = 1.5e-3; int i = 'sh1F_f; \"str\\n\"",
+      "/* unterminated comment\n a", "1'bx 1'bX 'B0 'B1 '0 '1 4 'b 01xz?",
+      "#~@\\escaped#~@ [ * ] @ ( * ) (*attr*) <->",
+  };
+  for (const std::string& snippet : snippets) {
+    expectSameTokens(snippet, true, snippet);
+    expectSameTokens(snippet, false, snippet);
+  }
+}
+
+#if defined(SURELOG_GRAMMAR_DIR)
+// ANTLR escape sequences of a grammar literal
+std::string unescape(const std::string& literal) {
+  std::string text;
+  for (size_t i = 0; i < literal.size(); i++) {
+    if ((literal[i] != '\\') || (i + 1 == literal.size())) {
+      text += literal[i];
+      continue;
+    }
+    switch (literal[++i]) {
+      case 'n': text += '\n'; break;
+      case 'r': text += '\r'; break;
+      case 't': text += '\t'; break;
+      default: text += literal[i]; break;
+    }
+  }
+  return text;
+}
+
+// Every rule of SV3_1aLexer.g4 made of a single literal, lexed alone: the
+// token is the one of the first enabled rule matching the whole literal, as
+// the generated lexer decides (longest match, then rule order). The names
+// are compared through the vocabulary of the generated lexer.
+TEST(SV3_1aFastLexerTest, LiteralRulesOfTheGrammar) {
+  std::ifstream grammar(std::filesystem::path(SURELOG_GRAMMAR_DIR) /
+                        "SV3_1aLexer.g4");
+  ASSERT_TRUE(grammar.good());
+  const std::regex rule(
+      R"(^([A-Za-z_][A-Za-z_0-9]*)\s*:\s*'((?:[^'\\]|\\.)+)'\s*)"
+      R"((\{\s*sverilog\s*\}\?)?\s*;)");
+  // Literal -> name of the first rule matching it, with and without
+  // sverilog
+  std::map<std::string, std::string> rules[2];
+  std::vector<std::string> svOnly;
+  std::string line;
+  while (std::getline(grammar, line)) {
+    std::smatch match;
+    if (!std::regex_search(line, match, rule)) continue;
+    const std::string text = unescape(match[2]);
+    rules[true].emplace(text, match[1]);
+    if (match[3].matched) {
+      svOnly.push_back(text);
+    } else {
+      rules[false].emplace(text, match[1]);
+    }
+  }
+  ASSERT_GT(rules[true].size(), 300);
+  // Guarded keywords are identifiers in Verilog files
+  for (const std::string& text : svOnly) {
+    rules[false].emplace(text, "Simple_identifier");
+  }
+
+  antlr4::ANTLRInputStream input;
+  SV3_1aLexer reference(&input);
+  const antlr4::dfa::Vocabulary& vocabulary = reference.getVocabulary();
+  for (bool sverilog : {true, false}) {
+    for (const auto& [text, name] : rules[sverilog]) {
+      SV3_1aFastLexer lexer(text, "test.sv");
+      lexer.sverilog = sverilog;
+      std::unique_ptr<antlr4::Token> token = lexer.nextToken();
+      EXPECT_EQ(vocabulary.getSymbolicName(token->getType()), name)
+          << text << " sverilog: " << sverilog;
+      EXPECT_EQ(token->getText(), text);
+      EXPECT_EQ(lexer.nextToken()->getType(), antlr4::Token::EOF) << text;
+    }
+  }
+}
+#endif
+
+#if defined(SURELOG_TESTS_DIR)
+// Token-stream equality over the regression test corpus
+TEST(SV3_1aFastLexerTest, SameTokensOverTestCorpus) {
+  namespace fs = std::filesystem;
+  for (const fs::directory_entry& entry :
+       fs::recursive_directory_iterator(SURELOG_TESTS_DIR)) {
+    const fs::path& path = entry.path();
+    if (!entry.is_regular_file() ||
+        ((path.extension() != ".sv") && (path.extension() != ".v"))) {
+      continue;
+    }
+    const std::string text = FileUtils::getFileContent(path);
+    expectSameTokens(text, true, path.string());
+    if (HasFatalFailure()) return;
+  }
+}
+#endif
+}  // namespace
+}  // namespace SURELOG
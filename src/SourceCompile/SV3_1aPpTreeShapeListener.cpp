@@ -309,8 +309,12 @@ void SV3_1aPpTreeShapeListener::enterInclude_directive(
         }
       }
     }
-    std::string pp_result = pp->getPreProcessedFileContent();
-    if (!pp_result.empty()) m_pp->append(pre + pp_result + post);
+    const PPOutputBuffer &pp_result = pp->getPreProcessedOutput();
+    if (!pp_result.empty()) {
+      m_pp->append(pre);
+      m_pp->append(pp_result);
+      m_pp->append(post);
+    }
     if (ctx->macro_instance()) {
       m_append_paused_context = ctx;
       m_pp->pauseAppend();
@@ -0,0 +1,154 @@
+/*
+ Copyright 2021 The Surelog Team.
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+ http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <Surelog/SourceCompile/SV3_1aStreamingListener.h>
+#include <Surelog/SourceCompile/SV3_1aTreeShapeListener.h>
+#include <antlr4-runtime.h>
+#include <parser/SV3_1aParser.h>
+
+#include <exception>
+
+namespace SURELOG {
+
+// Rule of the parent of a parse tree node, INVALID_INDEX for the root
+static size_t parentRule(const antlr4::tree::ParseTree* tree) {
+  if (tree->parent == nullptr) return INVALID_INDEX;
+  return static_cast<const antlr4::RuleContext*>(tree->parent)
+      ->getRuleIndex();
+}
+
+// top_level_rule and source_text, forwarded event by event
+static bool isOuterRule(const antlr4::ParserRuleContext* ctx) {
+  const size_t rule = ctx->getRuleIndex();
+  return (rule == SV3_1aParser::RuleTop_level_rule) ||
+         ((rule == SV3_1aParser::RuleSource_text) &&
+          (parentRule(ctx) == SV3_1aParser::RuleTop_level_rule));
+}
+
+// Children of the outer rules (null_rule, timeunits_declaration,
+// description), walked as a whole then released
+static bool isOuterChild(const antlr4::tree::ParseTree* tree) {
+  const size_t rule = parentRule(tree);
+  return (rule == SV3_1aParser::RuleTop_level_rule) ||
+         (rule == SV3_1aParser::RuleSource_text);
+}
+
+SV3_1aStreamingListener::SV3_1aStreamingListener(
+    SV3_1aTreeShapeListener* listener, antlr4::Parser* parser)
+    : m_listener(listener), m_parser(parser), m_replayed(0) {}
+
+bool SV3_1aStreamingListener::forward_(antlr4::tree::ParseTree* tree) {
+  if (m_replayed < m_steps.size()) {
+    Step& step = m_steps[m_replayed];
+    const antlr4::RuleContext* ctx =
+        dynamic_cast<const antlr4::RuleContext*>(tree);
+    const size_t rule = ctx ? ctx->getRuleIndex() : INVALID_INDEX;
+    if (rule == step.m_rule) {
+      if (step.m_object >= 0) m_listener->aliasContext(tree, step.m_object);
+      ++m_replayed;
+      return false;
+    }
+    // The re-parse took another path: the objects built past this point
+    // are left orphan, the new ones get built
+    m_steps.resize(m_replayed);
+  }
+  Step step;
+  const antlr4::RuleContext* ctx =
+      dynamic_cast<const antlr4::RuleContext*>(tree);
+  step.m_rule = ctx ? ctx->getRuleIndex() : INVALID_INDEX;
+  step.m_object = -1;
+  m_steps.push_back(step);
+  ++m_replayed;
+  return true;
+}
+
+void SV3_1aStreamingListener::visitTerminal(antlr4::tree::TerminalNode* node) {
+  if (isOuterChild(node) && forward_(node)) m_listener->visitTerminal(node);
+}
+
+void SV3_1aStreamingListener::visitErrorNode(antlr4::tree::ErrorNode* node) {
+  if (isOuterChild(node) && forward_(node)) m_listener->visitErrorNode(node);
+}
+
+void SV3_1aStreamingListener::enterEveryRule(antlr4::ParserRuleContext* ctx) {
+  if (isOuterRule(ctx)) {
+    if (forward_(ctx)) {
+      m_listener->enterEveryRule(ctx);
+      ctx->enterRule(m_listener);
+    }
+  } else if (isOuterChild(ctx)) {
+    // ctx is the last context created, everything past it is its sub-tree
+    m_trackerMark = m_parser->getTreeTracker().size();
+  }
+}
+
+void SV3_1aStreamingListener::exitEveryRule(antlr4::ParserRuleContext* ctx) {
+  // Exits are also triggered while a bail out exception unwinds the rules,
+  // the contexts are incomplete and will be re-parsed
+  if (std::uncaught_exceptions() > 0) return;
+  if (isOuterRule(ctx)) {
+    if (forward_(ctx)) {
+      ctx->exitRule(m_listener);
+      m_listener->exitEveryRule(ctx);
+      m_steps.back().m_object = m_listener->ObjectIndexFromContext(ctx);
+    }
+    if (ctx->getRuleIndex() == SV3_1aParser::RuleTop_level_rule) {
+      m_exitedTopLevel = true;
+    }
+  } else if (isOuterChild(ctx)) {
+    if (forward_(ctx)) {
+      antlr4::tree::ParseTreeWalker::DEFAULT.walk(m_listener, ctx);
+      m_steps.back().m_object = m_listener->ObjectIndexFromContext(ctx);
+    }
+    release_(ctx);
+  }
+}
+
+void SV3_1aStreamingListener::release_(antlr4::ParserRuleContext* ctx) {
+  // The object indexes live in the contexts themselves, nothing refers to
+  // the deleted ones anymore
+  ctx->children.clear();
+  m_parser->getTreeTracker().release(m_trackerMark);
+}
+
+void SV3_1aStreamingListener::restart() {
+  // Parser::reset() deletes the whole tree, the steps only keep rules and
+  // object indexes
+  m_replayed = 0;
+  m_exitedTopLevel = false;
+}
+
+void SV3_1aStreamingListener::finish(antlr4::ParserRuleContext* topLevel) {
+  if (m_exitedTopLevel) return;
+  for (antlr4::tree::ParseTree* child : topLevel->children) {
+    if (antlr4::tree::ErrorNode* node =
+            dynamic_cast<antlr4::tree::ErrorNode*>(child)) {
+      visitErrorNode(node);
+    } else if (antlr4::tree::TerminalNode* node =
+                   dynamic_cast<antlr4::tree::TerminalNode*>(child)) {
+      visitTerminal(node);
+    } else {
+      antlr4::ParserRuleContext* ctx =
+          static_cast<antlr4::ParserRuleContext*>(child);
+      if (ctx->getRuleIndex() == SV3_1aParser::RuleSource_text) {
+        exitEveryRule(ctx);
+      }
+    }
+  }
+  exitEveryRule(topLevel);
+}
+
+}  // namespace SURELOG
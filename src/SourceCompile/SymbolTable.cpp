@@ -23,14 +23,41 @@
 
 #include <Surelog/SourceCompile/SymbolTable.h>
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 
 namespace SURELOG {
 
-SymbolTable::SymbolTable() : m_idCounter(getBadId()) {
+SymbolTable::SymbolTable() : m_shards(new Shard[kShardCount]) {
   registerSymbol(getBadSymbol());
 }
 
+SymbolTable::SymbolTable(const SymbolTable& other)
+    : m_shards(new Shard[kShardCount]) {
+  // Every id appended is in the index before its shard is unlocked
+  std::vector<std::shared_lock<std::shared_mutex>> shardLocks;
+  for (unsigned int i = 0; i < kShardCount; ++i) {
+    shardLocks.emplace_back(other.m_shards[i].m_mutex);
+    m_shards[i].m_slots = other.m_shards[i].m_slots;
+    m_shards[i].m_count = other.m_shards[i].m_count;
+  }
+  std::lock_guard<std::mutex> appendLock(
+      const_cast<std::mutex&>(other.m_appendMutex));
+  const SymbolId size = other.m_size.load(std::memory_order_relaxed);
+  if (size == 0) return;
+  const size_t lastSegment = (size - 1) >> kSegmentBits;
+  Directory* const directory = directory_(lastSegment);
+  for (size_t segment = 0; segment < lastSegment; ++segment) {
+    m_segments.push_back(other.m_segments[segment]);
+    (*directory)[segment] = m_segments.back().get();
+  }
+  // The original keeps appending to its last block
+  m_segments.emplace_back(new Segment(*other.m_segments[lastSegment]));
+  (*directory)[lastSegment] = m_segments.back().get();
+  m_size.store(size, std::memory_order_release);
+}
+
 SymbolTable::~SymbolTable() {}
 
 const std::string& SymbolTable::getBadSymbol() {
@@ -43,35 +70,124 @@ const std::string& SymbolTable::getEmptyMacroMarker() {
   return k_emptyMacroMarker;
 }
 
+uint64_t SymbolTable::hash_(std::string_view symbol) {
+  return std::hash<std::string_view>()(symbol);
+}
+
+SymbolTable::Shard& SymbolTable::shard_(uint64_t hash) const {
+  // The high bits pick the shard, the low bits the slot
+  return m_shards[(hash >> 32) % kShardCount];
+}
+
+bool SymbolTable::find_(const Shard& shard, std::string_view symbol,
+                        uint64_t hash, SymbolId* id) const {
+  if (shard.m_slots.empty()) return false;
+  const uint64_t tag = hash & 0xFFFFFFFFULL;
+  const size_t mask = shard.m_slots.size() - 1;
+  for (size_t i = tag & mask;; i = (i + 1) & mask) {
+    const uint64_t slot = shard.m_slots[i];
+    if (slot == 0) return false;
+    if (((slot >> 32) == tag) &&
+        (getSymbol((slot & 0xFFFFFFFFULL) - 1) == symbol)) {
+      *id = (slot & 0xFFFFFFFFULL) - 1;
+      return true;
+    }
+  }
+}
+
+void SymbolTable::insert_(Shard& shard, uint64_t hash, SymbolId id) {
+  assert(id < 0xFFFFFFFFULL);
+  if (2 * (shard.m_count + 1) > shard.m_slots.size()) {
+    // Keep the load factor under 1/2, the tags give the new positions
+    std::vector<uint64_t> slots(
+        shard.m_slots.empty() ? 64 : 2 * shard.m_slots.size(), 0);
+    const size_t mask = slots.size() - 1;
+    for (const uint64_t slot : shard.m_slots) {
+      if (slot == 0) continue;
+      size_t i = (slot >> 32) & mask;
+      while (slots[i] != 0) i = (i + 1) & mask;
+      slots[i] = slot;
+    }
+    shard.m_slots.swap(slots);
+  }
+  const uint64_t tag = hash & 0xFFFFFFFFULL;
+  const size_t mask = shard.m_slots.size() - 1;
+  size_t i = tag & mask;
+  while (shard.m_slots[i] != 0) i = (i + 1) & mask;
+  shard.m_slots[i] = (tag << 32) | (id + 1);
+  ++shard.m_count;
+}
+
+SymbolTable::Directory* SymbolTable::directory_(size_t segment) {
+  Directory* directory = m_directory.load(std::memory_order_relaxed);
+  if ((directory != nullptr) && (segment < directory->size())) {
+    return directory;
+  }
+  // Readers may still hold the old directory, it is kept alive
+  size_t size = directory ? directory->size() : 64;
+  while (size <= segment) size *= 2;
+  m_directories.emplace_back(new Directory(size, nullptr));
+  if (directory) {
+    std::copy(directory->begin(), directory->end(),
+              m_directories.back()->begin());
+  }
+  directory = m_directories.back().get();
+  m_directory.store(directory, std::memory_order_release);
+  return directory;
+}
+
+SymbolId SymbolTable::append_(std::string_view symbol) {
+  std::lock_guard<std::mutex> lock(m_appendMutex);
+  const SymbolId id = m_size.load(std::memory_order_relaxed);
+  const size_t segment = id >> kSegmentBits;
+  Directory* const directory = directory_(segment);
+  if (segment == m_segments.size()) {
+    m_segments.emplace_back(new Segment());
+    (*directory)[segment] = m_segments.back().get();
+  }
+  // Not published yet, no reader looks at that string
+  m_segments[segment]->at(id & (kSegmentSize - 1)) = symbol;
+  m_size.store(id + 1, std::memory_order_release);
+  return id;
+}
+
 SymbolId SymbolTable::registerSymbol(std::string_view symbol) {
   assert(symbol.data());
-  auto found = m_symbol2IdMap.find(symbol);
-  if (found != m_symbol2IdMap.end()) {
-    return found->second;
+  const uint64_t hash = hash_(symbol);
+  Shard& shard = shard_(hash);
+  SymbolId id = getBadId();
+  {
+    std::shared_lock<std::shared_mutex> lock(shard.m_mutex);
+    if (find_(shard, symbol, hash, &id)) return id;
   }
-  m_id2SymbolMap.emplace_back(new std::string(symbol));
-  const std::string_view normalized_symbol = *m_id2SymbolMap.back();
-  const auto inserted = m_symbol2IdMap.insert({normalized_symbol, m_idCounter});
-  assert(inserted.second);  // This new insert must succeed.
-  m_idCounter++;
-  return inserted.first->second;
+  std::unique_lock<std::shared_mutex> lock(shard.m_mutex);
+  // Another thread may have registered it in between
+  if (find_(shard, symbol, hash, &id)) return id;
+  id = append_(symbol);
+  insert_(shard, hash, id);
+  return id;
 }
 
 SymbolId SymbolTable::getId(std::string_view symbol) const {
-  auto found = m_symbol2IdMap.find(symbol);
-  return (found == m_symbol2IdMap.end()) ? getBadId() : found->second;
+  const uint64_t hash = hash_(symbol);
+  const Shard& shard = shard_(hash);
+  std::shared_lock<std::shared_mutex> lock(shard.m_mutex);
+  SymbolId id = getBadId();
+  return find_(shard, symbol, hash, &id) ? id : getBadId();
 }
 
 const std::string& SymbolTable::getSymbol(SymbolId id) const {
-  if (id >= m_id2SymbolMap.size()) return getBadSymbol();
-  return *m_id2SymbolMap[id];
+  if (id >= m_size.load(std::memory_order_acquire)) return getBadSymbol();
+  const Directory* directory = m_directory.load(std::memory_order_acquire);
+  return (*(*directory)[id >> kSegmentBits])[id & (kSegmentSize - 1)];
 }
 
 std::vector<std::string> SymbolTable::getSymbols() const {
+  const SymbolId size = m_size.load(std::memory_order_acquire);
   std::vector<std::string> result;
-  result.reserve(m_id2SymbolMap.size());
-  for (const auto& s : m_id2SymbolMap) {
-    result.push_back(*s);
+  result.reserve(size);
+  for (SymbolId id = 0; id < size; ++id) {
+    result.push_back(getSymbol(id));
   }
   return result;
 }
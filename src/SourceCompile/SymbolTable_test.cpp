@@ -20,6 +20,7 @@
 
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace SURELOG {
@@ -93,5 +94,61 @@ TEST(SymbolTableTest, SymbolStringsAreStableAfterTableCopy) {
     EXPECT_EQ(before_data, after_data);
   }
 }
+
+TEST(SymbolTableTest, TableCopySharesFilledBlocks) {
+  SymbolTable table;
+  std::vector<SymbolId> ids;
+  for (int i = 0; i < 3000; ++i) {
+    ids.push_back(table.registerSymbol("sym" + std::to_string(i)));
+  }
+  const std::string longSymbol(100, 'x');
+  const SymbolId longId = table.registerSymbol(longSymbol);
+
+  SymbolTable table_copy(table);
+  EXPECT_EQ(table_copy.size(), table.size());
+  // The first block is full: the copy points to the very same strings
+  EXPECT_EQ(table_copy.getSymbol(ids[1]).data(),
+            table.getSymbol(ids[1]).data());
+  for (int i = 0; i < 3000; ++i) {
+    EXPECT_EQ(table_copy.getId("sym" + std::to_string(i)), ids[i]);
+  }
+  EXPECT_EQ(table_copy.getSymbol(longId), longSymbol);
+
+  // The tables diverge after the copy
+  const SymbolId copy_id = table_copy.registerSymbol("copy");
+  const SymbolId orig_id = table.registerSymbol("original");
+  EXPECT_EQ(copy_id, orig_id);
+  EXPECT_EQ(table.getId("copy"), SymbolTable::getBadId());
+  EXPECT_EQ(table_copy.getId("original"), SymbolTable::getBadId());
+  EXPECT_EQ(table.getSymbol(orig_id), "original");
+  EXPECT_EQ(table_copy.getSymbol(copy_id), "copy");
+}
+
+TEST(SymbolTableTest, ConcurrentRegistration) {
+  SymbolTable table;
+  constexpr int kThreads = 8;
+  constexpr int kSymbols = 20000;
+
+  // All threads register the same symbols, in different orders
+  std::vector<std::vector<SymbolId>> ids(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&table, &ids, t] {
+      ids[t].resize(kSymbols);
+      for (int i = 0; i < kSymbols; ++i) {
+        const int n = (t % 2) ? (kSymbols - 1 - i) : i;
+        ids[t][n] = table.registerSymbol("sym" + std::to_string(n));
+        EXPECT_EQ(table.getSymbol(ids[t][n]), "sym" + std::to_string(n));
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  for (int t = 1; t < kThreads; ++t) EXPECT_EQ(ids[t], ids[0]);
+  EXPECT_EQ(table.getSymbols().size(), kSymbols + 1);
+  for (int i = 0; i < kSymbols; ++i) {
+    EXPECT_EQ(table.getId("sym" + std::to_string(i)), ids[0][i]);
+  }
+}
 }  // namespace
 }  // namespace SURELOG
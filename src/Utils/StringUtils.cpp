@@ -24,6 +24,8 @@
 #include <Surelog/Utils/StringUtils.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <locale>
 #include <regex>
@@ -356,4 +358,56 @@ std::string StringUtils::unquoted(const std::string& text) {
   return text;
 }
 
+// Word-at-a-time (SWAR) helpers: test eight bytes in one go without
+// depending on a particular SIMD instruction set.
+static constexpr uint64_t kLowBytes = 0x0101010101010101ULL;
+static constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+static inline uint64_t loadWord(const char* p) {
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+static inline bool wordHasByte(uint64_t word, unsigned char c) {
+  const uint64_t x = word ^ (kLowBytes * c);
+  return ((x - kLowBytes) & ~x & kHighBits) != 0;
+}
+
+std::string_view::size_type StringUtils::findLastNonAscii(
+    std::string_view text) {
+  const char* const begin = text.data();
+  const char* p = begin + text.size();
+  while (p - begin >= 8) {
+    if (loadWord(p - 8) & kHighBits) break;
+    p -= 8;
+  }
+  while (p > begin) {
+    --p;
+    if (static_cast<unsigned char>(*p) & 0x80) return p - begin;
+  }
+  return std::string_view::npos;
+}
+
+void StringUtils::sanitizeSourceText(std::string& text) {
+  char* const data = text.data();
+  const size_t size = text.size();
+  size_t read = 0;
+  size_t write = 0;
+  while (read < size) {
+    while (read + 8 <= size) {
+      const uint64_t word = loadWord(data + read);
+      if ((word & kHighBits) || wordHasByte(word, '\r')) break;
+      if (write != read) std::memcpy(data + write, &word, sizeof(word));
+      read += 8;
+      write += 8;
+    }
+    if (read == size) break;
+    const char c = data[read++];
+    if (c == '\r') continue;
+    data[write++] = (static_cast<unsigned char>(c) & 0x80) ? ' ' : c;
+  }
+  text.resize(write);
+}
+
 }  // namespace SURELOG
@@ -254,5 +254,35 @@ TEST(StringUtilsTest, EvaluateEnvironmentVariables) {
             StringUtils::evaluateEnvVars("hello ${REGISTERED_EVAL_FOO} bar"));
 }
 
+TEST(StringUtilsTest, FindLastNonAscii) {
+  EXPECT_EQ(StringUtils::findLastNonAscii(""), std::string_view::npos);
+  EXPECT_EQ(StringUtils::findLastNonAscii("module top; endmodule\n"),
+            std::string_view::npos);
+  EXPECT_EQ(StringUtils::findLastNonAscii("\xC3"), size_t(0));
+  // Both inside and outside of the word-aligned section.
+  EXPECT_EQ(StringUtils::findLastNonAscii("a\xC3\xA9 module top; end"),
+            size_t(2));
+  EXPECT_EQ(StringUtils::findLastNonAscii("module top; endmodule \xA9"),
+            size_t(22));
+}
+
+TEST(StringUtilsTest, SanitizeSourceText) {
+  std::string text;
+  StringUtils::sanitizeSourceText(text);
+  EXPECT_EQ(text, "");
+
+  text = "module top;\nendmodule\n";
+  StringUtils::sanitizeSourceText(text);
+  EXPECT_EQ(text, "module top;\nendmodule\n");
+
+  text = "module top;\r\nendmodule\r\n";
+  StringUtils::sanitizeSourceText(text);
+  EXPECT_EQ(text, "module top;\nendmodule\n");
+
+  text = "// caf\xC3\xA9\r\nmodule top;\r\nendmodule";
+  StringUtils::sanitizeSourceText(text);
+  EXPECT_EQ(text, "// caf  \nmodule top;\nendmodule");
+}
+
 }  // namespace
 }  // namespace SURELOG
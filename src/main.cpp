@@ -30,6 +30,7 @@
 #endif
 
 #include <Surelog/API/PythonAPI.h>
+#include <Surelog/ErrorReporting/AsyncLogListener.h>
 #include <Surelog/ErrorReporting/Report.h>
 #include <Surelog/Utils/StringUtils.h>
 #include <Surelog/surelog.h>
@@ -50,7 +51,10 @@ unsigned int executeCompilation(
   bool noFatalErrors = true;
   unsigned int codedReturn = 0;
   SURELOG::SymbolTable* symbolTable = new SURELOG::SymbolTable();
-  SURELOG::ErrorContainer* errors = new SURELOG::ErrorContainer(symbolTable);
+  // The log file is written by a background thread
+  SURELOG::AsyncLogListener* logListener = new SURELOG::AsyncLogListener();
+  SURELOG::ErrorContainer* errors =
+      new SURELOG::ErrorContainer(symbolTable, logListener);
   SURELOG::CommandLineParser* clp = new SURELOG::CommandLineParser(
       errors, symbolTable, diff_comp_mode, fileunit);
   success = clp->parseCommandLine(argc, argv);
@@ -98,6 +102,7 @@ unsigned int executeCompilation(
     std::cout << "Command result: " << result << std::endl;
   }
   clp->logFooter();
+  logListener->flush();
   if (diff_comp_mode && fileunit) {
     SURELOG::Report* report = new SURELOG::Report();
     std::pair<bool, bool> results =
@@ -110,6 +115,7 @@ unsigned int executeCompilation(
   delete clp;
   delete symbolTable;
   delete errors;
+  delete logListener;  // Drains the log file
   if ((!noFatalErrors) || (!success)) codedReturn |= 1;
   if (parseOnly)
     return 0;
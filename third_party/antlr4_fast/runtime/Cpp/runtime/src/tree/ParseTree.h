@@ -37,6 +37,10 @@ namespace tree {
     // ml: memory is not managed here, but by the owning class. This is just for the structure.
     std::vector<ParseTree *> children;
 
+    /// Free for the tree listeners to annotate the node with, for instance
+    /// the index of the object they built for it. 0 until set.
+    uint64_t listenerData = 0;
+
     /// Print out a whole tree, not just a node, in LISP format
     /// {@code (root child1 .. childN)}. Print just a node if this is a leaf.
     virtual std::string toStringTree(bool pretty = false) = 0;
@@ -93,6 +97,18 @@ namespace tree {
       _allocated.clear();
     }
 
+    // Number of instances created so far.
+    size_t size() const { return _allocated.size(); }
+
+    // Deletes the instances created after the first "count" ones, for
+    // parse listeners that drop a sub-tree once they are done with it.
+    void release(size_t count) {
+      for (size_t i = count; i < _allocated.size(); ++i)
+        delete _allocated[i];
+      if (count < _allocated.size())
+        _allocated.resize(count);
+    }
+
   private:
     std::vector<ParseTree *> _allocated;
   };